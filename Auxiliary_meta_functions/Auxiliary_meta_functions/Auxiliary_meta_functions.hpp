@@ -1,3 +1,4 @@
 #pragma once
-#include "..\detail\Getters.hpp"
-#include "..\detail\Traits.hpp"
\ No newline at end of file
+#include "../detail/Getters.hpp"
+#include "../detail/Traits.hpp"
+#include "../detail/Niche.hpp"
\ No newline at end of file
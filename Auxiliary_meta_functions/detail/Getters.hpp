@@ -1,22 +1,65 @@
 #pragma once
+#include <cstddef>
+#include <type_traits>
+#include <utility>
 
+#if defined(__has_builtin)
+#if __has_builtin(__type_pack_element)
+#define META_FUNCTIONS_HAS_TYPE_PACK_ELEMENT
+#endif
+#endif
+
+// The lookups below do not recurse over the pack: their instantiation depth
+// does not grow with the number of types, so packs of hundreds of types stay
+// far from the template depth limit.
 namespace meta_functions {
-    template<size_t I, typename... Types>
-    struct _Get_type;
+    template<typename... Types>
+    inline constexpr bool _Always_false = false;
 
-    template<typename First_Type, typename... Types>
-    struct _Get_type<0, First_Type, Types...> {
-        using Type = typename First_Type;
+    template<typename Type>
+    struct _Type_tag {};
+
+    template<size_t I, typename Type>
+    struct _Indexed : _Type_tag<Type> {
+        using Element = Type;
     };
 
-    template<size_t I, typename First_Type, typename... Types>
-    struct _Get_type<I, First_Type, Types...> {
-        using Type = typename _Get_type<I - 1, Types...>::Type;
+    // Inherits _Indexed<I, T> for every element, so an element can be found
+    // by overload resolution against the bases instead of by recursion.
+    template<typename Sequence, typename... Types>
+    struct _Indexed_pack;
+
+    template<size_t... Is, typename... Types>
+    struct _Indexed_pack<std::index_sequence<Is...>, Types...> : _Indexed<Is, Types>... {};
+
+    template<typename... Types>
+    using _Indexed_pack_t = _Indexed_pack<std::index_sequence_for<Types...>, Types...>;
+
+    // Called qualified: argument-dependent lookup would complete the classes
+    // that Types point to, which breaks a type holding a Variant of pointers
+    // to itself while that type is still being instantiated.
+    template<size_t I, typename Type>
+    _Indexed<I, Type> _Select_by_index(const _Indexed<I, Type>&);
+
+    template<typename Type, size_t I>
+    std::integral_constant<size_t, I> _Select_by_type(const _Indexed<I, Type>&);
+
+    template<bool InRange, size_t I, typename... Types>
+    struct _Get_type_impl {};
+
+    template<size_t I, typename... Types>
+    struct _Get_type_impl<true, I, Types...> {
+#ifdef META_FUNCTIONS_HAS_TYPE_PACK_ELEMENT
+        using Type = __type_pack_element<I, Types...>;
+#else
+        using Type = typename decltype(meta_functions::_Select_by_index<I>(
+            std::declval<_Indexed_pack_t<Types...>>()))::Element;
+#endif
     };
 
-    template<size_t I>
-    struct _Get_type<I> {
-        static_assert(false, "Type not found");
+    template<size_t I, typename... Types>
+    struct _Get_type : _Get_type_impl<(I < sizeof...(Types)), I, Types...> {
+        static_assert(I < sizeof...(Types), "Type not found");
     };
 
     template<size_t I, typename... Types>
@@ -24,27 +67,41 @@ namespace meta_functions {
 
 
     template<typename First, typename... Types>
-    using _Get_first_t = First;
+    struct _Get_first {
+        using Type = First;
+    };
 
+    // Through a class template, so the alias can be used with a pack expansion.
+    template<typename... Types>
+    using _Get_first_t = typename _Get_first<Types...>::Type;
 
-    template<typename Type, typename... Types>
-    struct _Get_index;
-
-    template<typename Type, typename Head, typename... Types>
-    struct _Get_index<Type, Head, Types...> {
-        static constexpr size_t value = 1 + _Get_index<Type, Types...>::value;
-    };
 
+    // Position of the first occurrence of Type, or sizeof...(Types) if absent.
+    // A type that occurs once is found by deducing I from the only matching
+    // base; a repeated or absent type makes the deduction fail, and only then
+    // the pack is scanned.
     template<typename Type, typename... Types>
-    struct _Get_index<Type, Type, Types...> {
-        static constexpr size_t value = 0;
-    };
+    constexpr size_t _Find_index() noexcept {
+        if constexpr (requires { meta_functions::_Select_by_type<Type>(std::declval<_Indexed_pack_t<Types...>>()); }) {
+            return decltype(meta_functions::_Select_by_type<Type>(std::declval<_Indexed_pack_t<Types...>>()))::value;
+        }
+        else {
+            constexpr bool matches[] = { std::is_same_v<Type, Types>..., false };
+            for (size_t i = 0; i < sizeof...(Types); ++i) {
+                if (matches[i]) {
+                    return i;
+                }
+            }
+            return sizeof...(Types);
+        }
+    }
 
-    template<typename Type>
-    struct _Get_index<Type> {
-        static_assert(false, "Index not found");
+    template<typename Type, typename... Types>
+    struct _Get_index {
+        static constexpr size_t value = _Find_index<Type, Types...>();
+        static_assert(value < sizeof...(Types), "Index not found");
     };
 
     template<typename Type, typename... Types>
     static constexpr size_t _Get_index_v = _Get_index<Type, Types...>::value;
-}
\ No newline at end of file
+}
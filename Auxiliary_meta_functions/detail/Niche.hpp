@@ -0,0 +1,152 @@
+#pragma once
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+
+namespace meta_functions {
+    // Describes bit patterns that no valid object of Type ever holds. The
+    // primary template advertises none. A specialization sets count to the
+    // number of such patterns, offset and size to the bytes of Type they
+    // occupy, and provides
+    //     static void store(std::byte* field, std::size_t niche) noexcept;
+    //     static std::size_t load(const std::byte* field) noexcept;
+    // store writes pattern niche (< count) into the field; load returns the
+    // pattern found there, or count if the field belongs to a valid object.
+    template<typename Type>
+    struct niche_traits {
+        static constexpr std::size_t count = 0;
+    };
+
+    template<typename Type>
+    inline constexpr std::size_t niche_count_v = niche_traits<Type>::count;
+
+    // Niches of a trivially copyable Field at byte Offset whose valid values,
+    // read as an unsigned integer of the same size, never exceed Last: the
+    // values above Last are the niches. Meant for enums, bool and flag bytes.
+    template<typename Field, Field Last, std::size_t Offset = 0>
+    struct value_niche_traits {
+    private:
+        using _Bits = std::conditional_t<sizeof(Field) == 1, std::uint8_t,
+            std::conditional_t<sizeof(Field) == 2, std::uint16_t,
+            std::conditional_t<sizeof(Field) == 4, std::uint32_t, std::uint64_t>>>;
+
+        static_assert(sizeof(_Bits) == sizeof(Field) && std::is_trivially_copyable_v<Field>,
+            "Field must be a trivially copyable 1, 2, 4 or 8 byte type");
+
+        static constexpr _Bits _last = std::bit_cast<_Bits>(Last);
+
+    public:
+        static constexpr std::size_t offset = Offset;
+        static constexpr std::size_t size = sizeof(Field);
+        static constexpr std::size_t count =
+            static_cast<std::size_t>(std::numeric_limits<_Bits>::max() - _last);
+
+        static void store(std::byte* field, std::size_t niche) noexcept {
+            const _Bits bits = static_cast<_Bits>(_last + 1 + niche);
+            std::memcpy(field, &bits, sizeof(bits));
+        }
+
+        static std::size_t load(const std::byte* field) noexcept {
+            _Bits bits;
+            std::memcpy(&bits, field, sizeof(bits));
+            return bits > _last ? static_cast<std::size_t>(bits - _last - 1) : count;
+        }
+    };
+
+    // Only 0 and 1 are valid bool representations.
+    template<>
+    struct niche_traits<bool> : value_niche_traits<bool, true> {};
+
+    // No object lives in the first page, so a pointer that is null or points
+    // to an object never holds the addresses 1..4095.
+    template<typename Type>
+    struct niche_traits<Type*> {
+        static constexpr std::size_t offset = 0;
+        static constexpr std::size_t size = sizeof(Type*);
+        static constexpr std::size_t count = 4095;
+
+        static void store(std::byte* field, std::size_t niche) noexcept {
+            const std::uintptr_t address = niche + 1;
+            std::memcpy(field, &address, sizeof(address));
+        }
+
+        static std::size_t load(const std::byte* field) noexcept {
+            std::uintptr_t address;
+            std::memcpy(&address, field, sizeof(address));
+            return address - 1 < count ? static_cast<std::size_t>(address - 1) : count;
+        }
+    };
+
+    template<typename Type>
+    constexpr std::size_t _Niche_field_begin() noexcept {
+        if constexpr (niche_count_v<Type> > 0) {
+            return niche_traits<Type>::offset;
+        }
+        else {
+            return 0;
+        }
+    }
+
+    template<typename Type>
+    constexpr std::size_t _Niche_field_end() noexcept {
+        if constexpr (niche_count_v<Type> > 0) {
+            return niche_traits<Type>::offset + niche_traits<Type>::size;
+        }
+        else {
+            return 0;
+        }
+    }
+
+    inline constexpr std::size_t _No_dataful = static_cast<std::size_t>(-1);
+
+    // The alternative whose niche field carries the index (_No_dataful if
+    // none can) and the offset of every alternative. The dataful alternative
+    // is at 0 and needs a niche per other alternative plus one for "none";
+    // the others must be empty or fit in its bytes around the niche field.
+    template<std::size_t Count>
+    struct _Niche_layout {
+        std::size_t dataful = _No_dataful;
+        std::size_t offsets[Count] = {};
+    };
+
+    template<typename... Types>
+    constexpr _Niche_layout<sizeof...(Types)> _Make_niche_layout() noexcept {
+        constexpr std::size_t count = sizeof...(Types);
+        constexpr std::size_t sizes[] = { sizeof(Types)... };
+        constexpr std::size_t alignments[] = { alignof(Types)... };
+        constexpr bool empty[] = { std::is_empty_v<Types>... };
+        constexpr std::size_t niches[] = { niche_count_v<Types>... };
+        constexpr std::size_t field_begin[] = { _Niche_field_begin<Types>()... };
+        constexpr std::size_t field_end[] = { _Niche_field_end<Types>()... };
+
+        for (std::size_t dataful = 0; dataful < count; ++dataful) {
+            if (niches[dataful] < count) {
+                continue;
+            }
+
+            _Niche_layout<count> layout;
+            layout.dataful = dataful;
+            bool fits = true;
+            for (std::size_t i = 0; i < count && fits; ++i) {
+                if (i == dataful || empty[i] || sizes[i] <= field_begin[dataful]) {
+                    continue;
+                }
+                const std::size_t offset =
+                    (field_end[dataful] + alignments[i] - 1) / alignments[i] * alignments[i];
+                layout.offsets[i] = offset;
+                fits = offset + sizes[i] <= sizes[dataful];
+            }
+            if (fits) {
+                return layout;
+            }
+        }
+        return {};
+    }
+
+    template<typename... Types>
+    inline constexpr _Niche_layout<sizeof...(Types)> _Niche_layout_v = _Make_niche_layout<Types...>();
+}
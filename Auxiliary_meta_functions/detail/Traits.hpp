@@ -1,6 +1,7 @@
 #pragma once
 #include <type_traits>
 #include <concepts>
+#include <cstdint>
 #include <initializer_list>
 
 #include "Getters.hpp"
@@ -15,19 +16,14 @@ namespace meta_functions {
     concept _Is_index_of_alternative = (I < sizeof...(Types));
 
 
-    template<typename Type, typename... Types>
-    constexpr bool _are_unique_impl() {
-        if constexpr (sizeof...(Types) == 0) {
-            return true;
-        }
-        else {
-            return ((!std::is_same_v<Type, Types>) && ...)
-                && _are_unique_impl<Types...>();
-        }
-    }
+    // A type that occurs twice is inherited twice as a _Type_tag base of the
+    // indexed pack, which makes the conversion to that base ambiguous.
+    template<typename... Types>
+    inline constexpr bool _are_unique_v =
+        (std::is_convertible_v<_Indexed_pack_t<Types...>*, _Type_tag<Types>*> && ...);
 
     template<typename... Types>
-    concept _Is_pack_of_different_type = _are_unique_impl<Types...>();
+    concept _Is_pack_of_different_type = _are_unique_v<Types...>;
 
     template<typename... Types>
     concept _Is_pack_not_empty = sizeof...(Types) > 0;
@@ -64,6 +60,23 @@ namespace meta_functions {
     template<typename Type>
     concept _Is_assignable = std::is_assignable_v<std::remove_cvref_t<Type>&, Type>;
 
+    template<typename... Types>
+    concept _All_trivially_destructible = (std::is_trivially_destructible_v<Types> && ...);
+
+    template<typename... Types>
+    concept _All_trivially_copy_constructible =
+        (std::is_trivially_copy_constructible_v<Types> && ...);
+
+    template<typename... Types>
+    concept _All_trivially_move_constructible =
+        (std::is_trivially_move_constructible_v<Types> && ...);
+
+    template<typename... Types>
+    concept _All_trivially_copy_assignable =
+        ((std::is_trivially_copy_constructible_v<Types> &&
+            std::is_trivially_copy_assignable_v<Types> &&
+            std::is_trivially_destructible_v<Types>) && ...);
+
     template<typename... Types>
     concept _All_trivially_move_assignable =
         ((std::is_trivially_move_constructible_v<Types> &&
@@ -73,6 +86,21 @@ namespace meta_functions {
     template<typename... Types>
     concept _All_equality_comparable = (std::equality_comparable<Types> && ...);
 
+    // The largest value of the index type is reserved for the valueless state.
+    template<std::size_t Count>
+    using _Index_type_t =
+        std::conditional_t<(Count <= UINT8_MAX), std::uint8_t,
+        std::conditional_t<(Count <= UINT16_MAX), std::uint16_t, std::uint32_t>>;
+
+    // A trivially relocatable object can be moved to new storage by copying its
+    // bytes, after which the old bytes are dropped without running the
+    // destructor. Specialize as std::true_type to opt a type in.
+    template<typename Type>
+    struct is_trivially_relocatable : std::is_trivially_copyable<Type> {};
+
+    template<typename Type>
+    inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<Type>::value;
+
     template<typename Type>
     constexpr bool is_nothrow_equality_comparable_v =
         noexcept(std::declval<Type>() == std::declval<Type>());
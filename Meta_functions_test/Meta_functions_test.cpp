@@ -36,6 +36,27 @@ struct NoEqual {
     bool operator==(const NoEqual&) = delete;
 };
 
+template<size_t I>
+struct Tag {};
+
+template<typename Sequence>
+struct LargePack;
+
+template<size_t... Is>
+struct LargePack<std::index_sequence<Is...>> {
+    template<size_t I>
+    using type_at = _Get_type_t<I, Tag<Is>...>;
+
+    template<typename Type>
+    static constexpr size_t index_of = _Get_index_v<Type, Tag<Is>...>;
+
+    static constexpr bool unique = _Is_pack_of_different_type<Tag<Is>...>;
+    static constexpr bool unique_with_duplicate = _Is_pack_of_different_type<Tag<Is>..., Tag<0>>;
+};
+
+// Deeper than the default template instantiation depth of the compilers.
+using Pack2000 = LargePack<std::make_index_sequence<2000>>;
+
 TEST(MetaFunctionsTest_Getters, ReturnsCorrectTypeByIndex) {
     using T0 = _Get_type_t<0, int, double, char>;
     using T1 = _Get_type_t<1, int, double, char>;
@@ -80,6 +101,19 @@ TEST(MetaFunctionsTest_Traits, DetectsUniqueness) {
     EXPECT_FALSE((_Is_pack_of_different_type<int, double, int>));
 }
 
+TEST(MetaFunctionsTest_Getters, HandlesPacksDeeperThanTemplateDepthLimit) {
+    EXPECT_TRUE((std::is_same_v<Pack2000::type_at<0>, Tag<0>>));
+    EXPECT_TRUE((std::is_same_v<Pack2000::type_at<1999>, Tag<1999>>));
+    EXPECT_EQ(Pack2000::index_of<Tag<0>>, 0);
+    EXPECT_EQ(Pack2000::index_of<Tag<1999>>, 1999);
+    EXPECT_TRUE(Pack2000::unique);
+    EXPECT_FALSE(Pack2000::unique_with_duplicate);
+}
+
+TEST(MetaFunctionsTest_Getters, ReturnsFirstIndexOf_RepeatedType) {
+    EXPECT_EQ((_Get_index_v<int, double, int, int>), 1);
+}
+
 TEST(MetaFunctionsTest_Traits, DetectsNonEmptyPack) {
     EXPECT_TRUE((_Is_pack_not_empty<int>));
     EXPECT_FALSE((_Is_pack_not_empty<>));
@@ -149,4 +183,35 @@ TEST(MetaFunctionsTest_Traits, ValidatesEqualityComparability) {
 TEST(MetaFunctionsTest_Traits, ValidatesNoexceptEquality) {
     EXPECT_TRUE((is_nothrow_equality_comparable_v<int>));
     EXPECT_FALSE((is_nothrow_equality_comparable_v<ThrowingType>));
-}
\ No newline at end of file
+}
+
+TEST(MetaFunctionsTest_Traits, SelectsSmallestIndexType) {
+    EXPECT_TRUE((std::is_same_v<_Index_type_t<1>, std::uint8_t>));
+    EXPECT_TRUE((std::is_same_v<_Index_type_t<255>, std::uint8_t>));
+    EXPECT_TRUE((std::is_same_v<_Index_type_t<256>, std::uint16_t>));
+    EXPECT_TRUE((std::is_same_v<_Index_type_t<65535>, std::uint16_t>));
+    EXPECT_TRUE((std::is_same_v<_Index_type_t<65536>, std::uint32_t>));
+}
+
+enum class Flags : std::uint8_t { none, read, write };
+
+TEST(MetaFunctionsTest_Traits, AdvertisesNiches) {
+    EXPECT_EQ(niche_count_v<int>, 0);
+    EXPECT_EQ(niche_count_v<bool>, 254);
+    EXPECT_EQ(niche_count_v<int*>, 4095);
+    EXPECT_EQ((value_niche_traits<Flags, Flags::write>::count), 253);
+}
+
+TEST(MetaFunctionsTest_Traits, StoresAndLoadsNiches) {
+    using Traits = value_niche_traits<Flags, Flags::write>;
+    Flags flags = Flags::read;
+    EXPECT_EQ(Traits::load(reinterpret_cast<const std::byte*>(&flags)), Traits::count);
+
+    Traits::store(reinterpret_cast<std::byte*>(&flags), 5);
+    EXPECT_EQ(Traits::load(reinterpret_cast<const std::byte*>(&flags)), 5);
+
+    int* pointer = nullptr;
+    EXPECT_EQ(niche_traits<int*>::load(reinterpret_cast<const std::byte*>(&pointer)), 4095);
+    niche_traits<int*>::store(reinterpret_cast<std::byte*>(&pointer), 4094);
+    EXPECT_EQ(niche_traits<int*>::load(reinterpret_cast<const std::byte*>(&pointer)), 4094);
+}
@@ -0,0 +1,115 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include "../../Auxiliary_meta_functions/Auxiliary_meta_functions/Auxiliary_meta_functions.hpp"
+
+// Same interface as VariadicUnion, but at run time create/destroy/get reach
+// every alternative with a single non-recursive call whatever the position of
+// the type in the pack. The alternatives are members of a balanced tree of unions,
+// so they all start at the address of the storage and are reached directly
+// through it. Constant evaluation cannot reinterpret addresses; there the
+// member is found by descending the tree, log2 of the pack size levels deep.
+template<typename... Types>
+    requires meta_functions::_Is_pack_of_different_type<Types...>&&
+             meta_functions::_Is_pack_not_empty<Types...>
+class FlatStorage {
+    template<std::size_t First, std::size_t Count>
+    union _Node {
+        _Node<First, Count / 2> left;
+        _Node<First + Count / 2, Count - Count / 2> right;
+
+        constexpr _Node() {}
+
+        constexpr ~_Node()
+            requires meta_functions::_All_trivially_destructible<Types...> = default;
+
+        constexpr ~_Node() {}
+    };
+
+    template<std::size_t First>
+    union _Node<First, 1> {
+        meta_functions::_Get_type_t<First, Types...> value;
+
+        constexpr _Node() {}
+
+        constexpr ~_Node()
+            requires meta_functions::_All_trivially_destructible<Types...> = default;
+
+        constexpr ~_Node() {}
+    };
+
+    _Node<0, sizeof...(Types)> _root;
+
+    // The member holding the I-th alternative in node, which spans the
+    // alternatives First to First + Count - 1.
+    template<std::size_t I, std::size_t First, std::size_t Count, typename Node>
+    static constexpr auto& _member(Node& node) noexcept {
+        if constexpr (Count == 1) {
+            return node.value;
+        }
+        else if constexpr (I < First + Count / 2) {
+            return _member<I, First, Count / 2>(node.left);
+        }
+        else {
+            return _member<I, First + Count / 2, Count - Count / 2>(node.right);
+        }
+    }
+
+    template<typename Type, typename Node>
+    static constexpr auto* _member_address(Node& root) noexcept {
+        return std::addressof(_member<meta_functions::_Get_index_v<Type, Types...>, 0, sizeof...(Types)>(root));
+    }
+
+    template<typename Type>
+    constexpr Type* _address() noexcept {
+        if (std::is_constant_evaluated()) {
+            return _member_address<Type>(_root);
+        }
+        return std::launder(reinterpret_cast<Type*>(std::addressof(_root)));
+    }
+
+    template<typename Type>
+    constexpr const Type* _address() const noexcept {
+        if (std::is_constant_evaluated()) {
+            return _member_address<Type>(_root);
+        }
+        return std::launder(reinterpret_cast<const Type*>(std::addressof(_root)));
+    }
+
+public:
+    // Leaves the alternatives uninitialized; value-initializing the owner
+    // must not zero them.
+    constexpr FlatStorage() noexcept {}
+
+    template<typename Type, typename... Args>
+        requires meta_functions::_Is_type_present<Type, Types...> &&
+                 meta_functions::_Is_constructible_from_args<Type, Args...>
+    constexpr void create(Args&&... args) {
+        if (std::is_constant_evaluated()) {
+            std::construct_at(_member_address<Type>(_root), std::forward<Args>(args)...);
+        }
+        else {
+            std::construct_at(reinterpret_cast<Type*>(std::addressof(_root)), std::forward<Args>(args)...);
+        }
+    }
+
+    template<typename Type>
+        requires meta_functions::_Is_type_present<Type, Types...>
+    constexpr void destroy() noexcept {
+        std::destroy_at(_address<Type>());
+    }
+
+    template<typename Type>
+        requires meta_functions::_Is_type_present<Type, Types...>
+    constexpr Type& get() noexcept {
+        return *_address<Type>();
+    }
+
+    template<typename Type>
+        requires meta_functions::_Is_type_present<Type, Types...>
+    constexpr const Type& get() const noexcept {
+        return *_address<Type>();
+    }
+};
@@ -0,0 +1,136 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include "../../Auxiliary_meta_functions/Auxiliary_meta_functions/Auxiliary_meta_functions.hpp"
+
+// Same interface as FlatStorage, plus index/set_index: the storage itself
+// records which alternative is active, so no separate index is needed.
+// The dataful alternative (see meta_functions::_Make_niche_layout) marks
+// itself by holding a valid value in its niche field; any other alternative,
+// or none, is marked by a niche written there. is_viable is false when no
+// alternative can carry the index.
+template<typename... Types>
+    requires meta_functions::_Is_pack_of_different_type<Types...>&&
+             meta_functions::_Is_pack_not_empty<Types...>
+class NicheStorage {
+    template<typename>
+    friend struct meta_functions::niche_traits;
+
+    static constexpr std::size_t _count = sizeof...(Types);
+    static constexpr std::size_t _none = static_cast<std::size_t>(-1);
+    static constexpr auto _layout = meta_functions::_Niche_layout_v<Types...>;
+
+public:
+    static constexpr bool is_viable = _layout.dataful != meta_functions::_No_dataful;
+
+private:
+    using _Dataful = meta_functions::_Get_type_t<(is_viable ? _layout.dataful : 0), Types...>;
+
+public:
+    // Bytes of the dataful alternative's niche field, which holds the index.
+    static constexpr std::size_t index_offset = meta_functions::_Niche_field_begin<_Dataful>();
+    static constexpr std::size_t index_size =
+        meta_functions::_Niche_field_end<_Dataful>() - index_offset;
+
+private:
+    static constexpr std::size_t _sizes[] = { sizeof(Types)... };
+
+    alignas(Types...) std::byte _buffer[is_viable ? _sizes[_layout.dataful] : 1];
+
+    using _Niche = meta_functions::niche_traits<_Dataful>;
+
+    template<typename Type>
+    Type* _address() noexcept {
+        constexpr std::size_t offset = _layout.offsets[meta_functions::_Get_index_v<Type, Types...>];
+        return std::launder(reinterpret_cast<Type*>(_buffer + offset));
+    }
+
+    template<typename Type>
+    const Type* _address() const noexcept {
+        constexpr std::size_t offset = _layout.offsets[meta_functions::_Get_index_v<Type, Types...>];
+        return std::launder(reinterpret_cast<const Type*>(_buffer + offset));
+    }
+
+public:
+    // Leaves the buffer uninitialized; value-initializing the owner must not
+    // zero it.
+    NicheStorage() noexcept {}
+
+    template<typename Type, typename... Args>
+        requires meta_functions::_Is_type_present<Type, Types...> &&
+                 meta_functions::_Is_constructible_from_args<Type, Args...>
+    void create(Args&&... args) {
+        constexpr std::size_t offset = _layout.offsets[meta_functions::_Get_index_v<Type, Types...>];
+        std::construct_at(reinterpret_cast<Type*>(_buffer + offset), std::forward<Args>(args)...);
+    }
+
+    template<typename Type>
+        requires meta_functions::_Is_type_present<Type, Types...>
+    void destroy() noexcept {
+        std::destroy_at(_address<Type>());
+    }
+
+    template<typename Type>
+        requires meta_functions::_Is_type_present<Type, Types...>
+    Type& get() noexcept {
+        return *_address<Type>();
+    }
+
+    template<typename Type>
+        requires meta_functions::_Is_type_present<Type, Types...>
+    const Type& get() const noexcept {
+        return *_address<Type>();
+    }
+
+    // Index of the active alternative, or size_t(-1) for none. Only
+    // meaningful once set_index has been called after the last create.
+    std::size_t index() const noexcept {
+        const std::size_t niche = _Niche::load(_buffer + _Niche::offset);
+        if (niche == _Niche::count) {
+            return _layout.dataful;
+        }
+        if (niche >= _count - 1) {
+            return _none;
+        }
+        return niche < _layout.dataful ? niche : niche + 1;
+    }
+
+    // Marks alternative index (or none, for any index out of range) as
+    // active. The dataful alternative marks itself by being constructed.
+    void set_index(std::size_t index) noexcept {
+        if (index == _layout.dataful) {
+            return;
+        }
+        const std::size_t niche = index >= _count ? _count - 1
+            : index < _layout.dataful ? index : index - 1;
+        _Niche::store(_buffer + _Niche::offset, niche);
+    }
+};
+
+namespace meta_functions {
+    // The niches of the dataful alternative that the index encoding leaves
+    // unused: the first sizeof...(Types) mark the other alternatives and none.
+    template<typename... Types>
+        requires NicheStorage<Types...>::is_viable
+    struct niche_traits<NicheStorage<Types...>> {
+    private:
+        using _Niche = typename NicheStorage<Types...>::_Niche;
+        static constexpr std::size_t _used = sizeof...(Types);
+
+    public:
+        static constexpr std::size_t offset = _Niche::offset;
+        static constexpr std::size_t size = _Niche::size;
+        static constexpr std::size_t count = _Niche::count - _used;
+
+        static void store(std::byte* field, std::size_t niche) noexcept {
+            _Niche::store(field, _used + niche);
+        }
+
+        static std::size_t load(const std::byte* field) noexcept {
+            const std::size_t niche = _Niche::load(field);
+            return niche != _Niche::count && niche >= _used ? niche - _used : count;
+        }
+    };
+}
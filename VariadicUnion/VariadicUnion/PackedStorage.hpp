@@ -0,0 +1,140 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include "../../Auxiliary_meta_functions/Auxiliary_meta_functions/Auxiliary_meta_functions.hpp"
+
+
+namespace meta_functions {
+    template<std::size_t Count>
+    struct _Packed_layout {
+        std::size_t size = 0;
+        std::size_t index_offset = 0;
+        std::size_t offsets[Count] = {};
+    };
+
+    // Puts an Index at the offset that minimizes the total size: right after
+    // one of the alternatives (the largest one gives the union's tail
+    // padding) or at the very start. Alternatives that end before the index
+    // stay at 0, the others follow it at their own alignment. Padding inside
+    // an alternative is never used: copying the alternative may write it.
+    template<typename Index, typename... Types>
+    constexpr _Packed_layout<sizeof...(Types)> _Make_packed_layout() noexcept {
+        constexpr std::size_t count = sizeof...(Types);
+        constexpr std::size_t sizes[] = { sizeof(Types)... };
+        constexpr std::size_t alignments[] = { alignof(Types)... };
+        constexpr std::size_t alignment = std::max({ alignof(Index), alignof(Types)... });
+
+        constexpr auto align_up = [](std::size_t offset, std::size_t to) {
+            return (offset + to - 1) / to * to;
+        };
+
+        _Packed_layout<count> best;
+        for (std::size_t candidate = 0; candidate <= count; ++candidate) {
+            const std::size_t index_offset =
+                candidate == count ? 0 : align_up(sizes[candidate], alignof(Index));
+
+            _Packed_layout<count> layout;
+            layout.index_offset = index_offset;
+            std::size_t end = index_offset + sizeof(Index);
+            for (std::size_t i = 0; i < count; ++i) {
+                layout.offsets[i] = sizes[i] <= index_offset
+                    ? 0
+                    : align_up(index_offset + sizeof(Index), alignments[i]);
+                end = std::max(end, layout.offsets[i] + sizes[i]);
+            }
+            layout.size = align_up(end, alignment);
+
+            if (best.size == 0 || layout.size < best.size ||
+                (layout.size == best.size && layout.index_offset > best.index_offset)) {
+                best = layout;
+            }
+        }
+        return best;
+    }
+
+    template<typename Index, typename... Types>
+    inline constexpr _Packed_layout<sizeof...(Types)> _Packed_layout_v =
+        _Make_packed_layout<Index, Types...>();
+}
+
+// Same interface as NicheStorage: the smallest index type for the pack is
+// kept inside the buffer, in the union's tail padding or in front of the
+// alternatives, wherever meta_functions::_Make_packed_layout finds the
+// smallest layout. Placement into raw bytes cannot be constant-evaluated.
+template<typename... Types>
+    requires meta_functions::_Is_pack_of_different_type<Types...>&&
+             meta_functions::_Is_pack_not_empty<Types...>
+class PackedStorage {
+    using _Index = meta_functions::_Index_type_t<sizeof...(Types)>;
+
+    static constexpr auto _layout = meta_functions::_Packed_layout_v<_Index, Types...>;
+
+public:
+    static constexpr std::size_t index_offset = _layout.index_offset;
+    static constexpr std::size_t index_size = sizeof(_Index);
+
+private:
+    alignas(_Index) alignas(Types...) std::byte _buffer[_layout.size];
+
+    template<typename Type>
+    Type* _address() noexcept {
+        constexpr std::size_t offset = _layout.offsets[meta_functions::_Get_index_v<Type, Types...>];
+        return std::launder(reinterpret_cast<Type*>(_buffer + offset));
+    }
+
+    template<typename Type>
+    const Type* _address() const noexcept {
+        constexpr std::size_t offset = _layout.offsets[meta_functions::_Get_index_v<Type, Types...>];
+        return std::launder(reinterpret_cast<const Type*>(_buffer + offset));
+    }
+
+public:
+    // Leaves the buffer uninitialized; value-initializing the owner must not
+    // zero it.
+    PackedStorage() noexcept {}
+
+    template<typename Type, typename... Args>
+        requires meta_functions::_Is_type_present<Type, Types...> &&
+                 meta_functions::_Is_constructible_from_args<Type, Args...>
+    void create(Args&&... args) {
+        constexpr std::size_t offset = _layout.offsets[meta_functions::_Get_index_v<Type, Types...>];
+        std::construct_at(reinterpret_cast<Type*>(_buffer + offset), std::forward<Args>(args)...);
+    }
+
+    template<typename Type>
+        requires meta_functions::_Is_type_present<Type, Types...>
+    void destroy() noexcept {
+        std::destroy_at(_address<Type>());
+    }
+
+    template<typename Type>
+        requires meta_functions::_Is_type_present<Type, Types...>
+    Type& get() noexcept {
+        return *_address<Type>();
+    }
+
+    template<typename Type>
+        requires meta_functions::_Is_type_present<Type, Types...>
+    const Type& get() const noexcept {
+        return *_address<Type>();
+    }
+
+    // Index of the active alternative, or size_t(-1) for none.
+    std::size_t index() const noexcept {
+        _Index index;
+        std::memcpy(&index, _buffer + index_offset, sizeof(index));
+        return index == static_cast<_Index>(-1) ? static_cast<std::size_t>(-1) : index;
+    }
+
+    // Marks alternative index (or none, for any index out of range) as active.
+    void set_index(std::size_t index) noexcept {
+        const _Index stored = index < sizeof...(Types)
+            ? static_cast<_Index>(index)
+            : static_cast<_Index>(-1);
+        std::memcpy(_buffer + index_offset, &stored, sizeof(stored));
+    }
+};
@@ -12,6 +12,9 @@ union VariadicUnion<Head, Tail...> {
 public:
     constexpr VariadicUnion() {}
 
+    constexpr ~VariadicUnion()
+        requires meta_functions::_All_trivially_destructible<Head, Tail...> = default;
+
     constexpr ~VariadicUnion() {}
 
     template<typename Type, typename... Args>
@@ -22,7 +25,7 @@ public:
             std::construct_at(&head, std::forward<Args>(args)...);
         }
         else {
-            tail.create<Type>(std::forward<Args>(args)...);
+            tail.template create<Type>(std::forward<Args>(args)...);
         }
     }
 
@@ -33,7 +36,7 @@ public:
             head.~Head();
         }
         else {
-            tail.destroy<Type>();
+            tail.template destroy<Type>();
         }
     }
 
@@ -44,7 +47,7 @@ public:
             return head;
         }
         else {
-            return tail.get<Type>();
+            return tail.template get<Type>();
         }
     }
 
@@ -55,7 +58,7 @@ public:
             return head;
         }
         else {
-            return tail.get<Type>();
+            return tail.template get<Type>();
         }
     }
 };
\ No newline at end of file
@@ -1,5 +1,9 @@
 #include "pch.h"
+#include "FlatStorage.hpp"
+#include "NicheStorage.hpp"
+#include "PackedStorage.hpp"
 #include "VariadicUnion.hpp"
+#include <string>
 
 struct Tracker {
     static inline bool constructed = false;
@@ -71,4 +75,102 @@ TEST(VariadicUnionTest_get, InvalidTypeDoesNotCompile) {
     VariadicUnion<int, Tracker> storage;
     // auto& x = storage.get<NotConstructible>();
     SUCCEED();
-}
\ No newline at end of file
+}
+
+TEST(FlatStorageTest_create_destroy, TrackerConstructsAndDestroysCorrectly) {
+    Tracker::reset();
+    FlatStorage<int, Tracker, double> storage;
+    storage.create<Tracker>(123);
+    EXPECT_TRUE(Tracker::constructed);
+    EXPECT_EQ(storage.get<Tracker>().value, 123);
+
+    storage.destroy<Tracker>();
+    EXPECT_TRUE(Tracker::destroyed);
+}
+
+TEST(FlatStorageTest_get, ReturnsReferenceToReplacedAlternative) {
+    FlatStorage<int, std::string, double> storage;
+    storage.create<std::string>("flat storage keeps long strings on the heap");
+    EXPECT_EQ(storage.get<std::string>(), "flat storage keeps long strings on the heap");
+    storage.destroy<std::string>();
+
+    storage.create<double>(3.14);
+    const auto& view = storage;
+    EXPECT_DOUBLE_EQ(view.get<double>(), 3.14);
+}
+
+TEST(FlatStorageTest_layout, MatchesVariadicUnion) {
+    static_assert(sizeof(FlatStorage<char, int, double>) == sizeof(VariadicUnion<char, int, double>));
+    static_assert(alignof(FlatStorage<char, int, double>) == alignof(VariadicUnion<char, int, double>));
+    static_assert(sizeof(FlatStorage<char[3], short>) == sizeof(VariadicUnion<char[3], short>));
+    static_assert(std::is_trivially_copyable_v<FlatStorage<int, double>>);
+    static_assert(!std::is_trivially_destructible_v<FlatStorage<int, std::string>>);
+}
+
+namespace {
+    constexpr int flat_storage_round_trip() {
+        FlatStorage<int, std::string, double> storage;
+        storage.create<std::string>("abc");
+        const int size = static_cast<int>(storage.get<std::string>().size());
+        storage.destroy<std::string>();
+        storage.create<int>(4);
+        return size + storage.get<int>();
+    }
+}
+
+TEST(FlatStorageTest_constexpr, WorksInConstantExpressions) {
+    static_assert(flat_storage_round_trip() == 7);
+}
+
+struct Empty {};
+
+TEST(NicheStorageTest_layout, NeedsRoomAroundTheNicheField) {
+    static_assert(NicheStorage<bool, Empty>::is_viable);
+    static_assert(NicheStorage<int*, Empty, Tracker>::is_viable == false);
+    static_assert(NicheStorage<bool, int*>::is_viable == false);
+    static_assert(NicheStorage<int, Empty>::is_viable == false);
+    static_assert(sizeof(NicheStorage<bool, Empty>) == sizeof(bool));
+    static_assert(std::is_trivially_copyable_v<NicheStorage<int*, Empty>>);
+}
+
+TEST(NicheStorageTest_index, RoundTripsEveryAlternative) {
+    NicheStorage<bool, Empty> storage;
+    storage.create<bool>(true);
+    storage.set_index(0);
+    EXPECT_EQ(storage.index(), 0);
+    EXPECT_TRUE(storage.get<bool>());
+
+    storage.create<Empty>();
+    storage.set_index(1);
+    EXPECT_EQ(storage.index(), 1);
+
+    storage.set_index(static_cast<std::size_t>(-1));
+    EXPECT_EQ(storage.index(), static_cast<std::size_t>(-1));
+}
+
+TEST(PackedStorageTest_layout, PutsTheIndexWhereItCostsNothing) {
+    static_assert(sizeof(PackedStorage<char[13], double>) == 16);
+    static_assert(PackedStorage<char[13], double>::index_offset == 13);
+    static_assert(PackedStorage<char[13], double>::index_size == 1);
+    // No padding anywhere, so the index goes in front of the small-aligned
+    // alternative or after the union at no difference in size.
+    static_assert(sizeof(PackedStorage<char[8], double>) == 16);
+    static_assert(std::is_trivially_copyable_v<PackedStorage<int, double>>);
+}
+
+TEST(PackedStorageTest_index, KeepsIndexBesideTheAlternative) {
+    PackedStorage<char[13], double, Tracker> storage;
+    storage.create<Tracker>(7);
+    storage.set_index(2);
+    EXPECT_EQ(storage.index(), 2);
+    EXPECT_EQ(storage.get<Tracker>().value, 7);
+    storage.destroy<Tracker>();
+
+    storage.create<double>(1.5);
+    storage.set_index(1);
+    EXPECT_EQ(storage.index(), 1);
+    EXPECT_DOUBLE_EQ(storage.get<double>(), 1.5);
+
+    storage.set_index(static_cast<std::size_t>(-1));
+    EXPECT_EQ(storage.index(), static_cast<std::size_t>(-1));
+}
@@ -0,0 +1,158 @@
+#pragma once
+#include <cassert>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include "../detail/BoxPool.hpp"
+#include "../../Auxiliary_meta_functions/Auxiliary_meta_functions/Auxiliary_meta_functions.hpp"
+
+
+// Marks an alternative of Variant to be kept out of line: Variant<Small,
+// Boxed<Large>> stores a pointer to a Large allocated from a size-class pool
+// (variant_detail::_Box_pool) instead of Large itself, so the rare large
+// alternative no longer sets the size of every Variant. Variant names the
+// alternative Large: get<Large>, emplace<Large>, visit and the rest see a
+// Large&. Copying a Boxed copies the value into a new box; moving one moves
+// the pointer and leaves the source without a value, so a Variant with a
+// Boxed alternative becomes valueless when it is moved from (see
+// Variant::never_valueless) rather than exposing the empty box.
+template<typename Type>
+    requires std::is_object_v<Type> && (!std::is_array_v<Type>) && std::is_destructible_v<Type>
+class Boxed final {
+private:
+    Type* _value = nullptr;
+
+    // Returns the block to the pool if the constructor throws.
+    struct _Block_guard {
+        void* memory;
+
+        ~_Block_guard() {
+            if (memory != nullptr) {
+                variant_detail::_Box_pool::deallocate(memory, sizeof(Type), alignof(Type));
+            }
+        }
+    };
+
+    template<typename... Args>
+    static Type* _make(Args&&... args) {
+        _Block_guard guard{ variant_detail::_Box_pool::allocate(sizeof(Type), alignof(Type)) };
+        Type* value = ::new (guard.memory) Type(std::forward<Args>(args)...);
+        guard.memory = nullptr;
+        return value;
+    }
+
+    void _release() noexcept {
+        if (_value != nullptr) {
+            std::destroy_at(_value);
+            variant_detail::_Box_pool::deallocate(_value, sizeof(Type), alignof(Type));
+            _value = nullptr;
+        }
+    }
+
+public:
+    template<typename... Args>
+        requires std::is_constructible_v<Type, Args...>
+    explicit Boxed(std::in_place_t, Args&&... args)
+        : _value(_make(std::forward<Args>(args)...)) {}
+
+    Boxed(const Boxed& other)
+        requires std::is_copy_constructible_v<Type>
+        : _value(other._value != nullptr ? _make(*other._value) : nullptr) {}
+
+    Boxed(Boxed&& other) noexcept
+        : _value(std::exchange(other._value, nullptr)) {}
+
+    ~Boxed() {
+        _release();
+    }
+
+    Boxed& operator=(const Boxed& other)
+        requires std::is_copy_constructible_v<Type> && std::is_copy_assignable_v<Type>
+    {
+        if (other._value == nullptr) {
+            _release();
+        }
+        else if (_value != nullptr) {
+            *_value = *other._value;
+        }
+        else {
+            _value = _make(*other._value);
+        }
+        return *this;
+    }
+
+    Boxed& operator=(Boxed&& other) noexcept {
+        if (this != std::addressof(other)) {
+            _release();
+            _value = std::exchange(other._value, nullptr);
+        }
+        return *this;
+    }
+
+    // Assigns to the boxed value, or boxes a new one if there is none.
+    template<typename Other>
+        requires (!std::is_same_v<std::remove_cvref_t<Other>, Boxed>) &&
+                 std::is_constructible_v<Type, Other> && std::is_assignable_v<Type&, Other>
+    Boxed& operator=(Other&& value) {
+        if (_value != nullptr) {
+            *_value = std::forward<Other>(value);
+        }
+        else {
+            _value = _make(std::forward<Other>(value));
+        }
+        return *this;
+    }
+
+    friend void swap(Boxed& lhs, Boxed& rhs) noexcept {
+        std::swap(lhs._value, rhs._value);
+    }
+
+    Type& operator*() noexcept {
+        assert(_value != nullptr && "Boxed: the value was moved out");
+        return *_value;
+    }
+
+    const Type& operator*() const noexcept {
+        assert(_value != nullptr && "Boxed: the value was moved out");
+        return *_value;
+    }
+};
+
+namespace meta_functions {
+    template<typename Type>
+    struct is_trivially_relocatable<Boxed<Type>> : std::true_type {};
+}
+
+namespace variant_detail {
+    template<typename Type>
+    struct _Unboxed {
+        using type = Type;
+    };
+
+    template<typename Type>
+    struct _Unboxed<Boxed<Type>> {
+        using type = Type;
+    };
+
+    // The alternative a Variant reports for what its storage holds.
+    template<typename Type>
+    using _Unboxed_t = typename _Unboxed<Type>::type;
+
+    template<typename Type>
+    inline constexpr bool _Is_boxed_v = !std::is_same_v<_Unboxed_t<Type>, Type>;
+
+    template<typename Type>
+    constexpr Type& _Unbox(Type& value) noexcept {
+        return value;
+    }
+
+    template<typename Type>
+    Type& _Unbox(Boxed<Type>& value) noexcept {
+        return *value;
+    }
+
+    template<typename Type>
+    const Type& _Unbox(const Boxed<Type>& value) noexcept {
+        return *value;
+    }
+}
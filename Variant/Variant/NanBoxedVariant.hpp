@@ -0,0 +1,262 @@
+#pragma once
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include "../detail/Access.hpp"
+#include "../detail/Dispatch.hpp"
+#include "Optional.hpp"
+
+
+namespace variant_detail {
+    // Alternatives that fit the 48-bit payload of a quiet NaN next to a double:
+    // arithmetic and enum types of at most 4 bytes, and object pointers, whose
+    // user-space addresses use the low 48 bits on the 64-bit targets we build.
+    template<typename Type>
+    concept _Nan_boxable =
+        (!std::is_same_v<Type, double>) && !std::is_const_v<Type> && !std::is_volatile_v<Type> &&
+        (((std::is_arithmetic_v<Type> || std::is_enum_v<Type>) && sizeof(Type) <= 4) ||
+         (std::is_pointer_v<Type> && !std::is_function_v<std::remove_pointer_t<Type>> &&
+          sizeof(Type) <= 8));
+
+    template<typename Type>
+    using _Payload_bits_t = std::conditional_t<sizeof(Type) == 1, std::uint8_t,
+        std::conditional_t<sizeof(Type) == 2, std::uint16_t,
+        std::conditional_t<sizeof(Type) == 4, std::uint32_t, std::uint64_t>>>;
+}
+
+// A Variant of double and up to six small alternatives in a single 64-bit
+// word. A double is stored as its own bits; every other alternative lives in
+// the payload of a negative quiet NaN whose top 16 bits, 0xFFF9 + index,
+// carry the index. All NaN doubles are therefore stored as one canonical
+// quiet NaN and lose their sign and payload. Which types fit is checked at
+// compile time (variant_detail::_Nan_boxable); a pointer is asserted to fit
+// in 48 bits where it is stored.
+// The surface follows Variant, except that get returns the alternative by
+// value and get_if returns it in an Optional, empty if another alternative is
+// active: there is no object of the alternative's type to refer to. It is
+// never valueless.
+template<typename... Types>
+    requires meta_functions::_Is_pack_of_different_type<Types...>&&
+             meta_functions::_Is_type_present<double, Types...>&&
+             (sizeof...(Types) <= 7) &&
+             ((std::is_same_v<Types, double> || variant_detail::_Nan_boxable<Types>) && ...)
+class NanBoxedVariant final {
+private:
+    template<size_t I>
+    using _Alternative = meta_functions::_Get_type_t<I, Types...>;
+
+    inline static constexpr std::size_t _double_index = meta_functions::_Get_index_v<double, Types...>;
+
+    inline static constexpr std::uint64_t _canonical_nan = 0x7FF8000000000000;
+    inline static constexpr std::uint64_t _boxed_tag = 0xFFF9;
+    inline static constexpr std::uint64_t _payload_mask = 0x0000FFFFFFFFFFFF;
+
+    std::uint64_t _bits = 0;
+
+    template<size_t I>
+    static std::uint64_t _encode(_Alternative<I> value) noexcept {
+        using Type = _Alternative<I>;
+        if constexpr (I == _double_index) {
+            const auto bits = std::bit_cast<std::uint64_t>(value);
+            return (bits & ~(std::uint64_t(1) << 63)) > 0x7FF0000000000000 ? _canonical_nan : bits;
+        }
+        else {
+            std::uint64_t payload;
+            if constexpr (std::is_pointer_v<Type>) {
+                payload = reinterpret_cast<std::uintptr_t>(value);
+                assert((payload & ~_payload_mask) == 0 && "NanBoxedVariant: pointer does not fit in 48 bits");
+            }
+            else {
+                payload = std::bit_cast<variant_detail::_Payload_bits_t<Type>>(value);
+            }
+            return ((_boxed_tag + I) << 48) | payload;
+        }
+    }
+
+    template<size_t I>
+    _Alternative<I> _decode() const noexcept {
+        using Type = _Alternative<I>;
+        if constexpr (I == _double_index) {
+            return std::bit_cast<double>(_bits);
+        }
+        else if constexpr (std::is_pointer_v<Type>) {
+            return reinterpret_cast<Type>(static_cast<std::uintptr_t>(_bits & _payload_mask));
+        }
+        else {
+            return std::bit_cast<Type>(static_cast<variant_detail::_Payload_bits_t<Type>>(_bits));
+        }
+    }
+
+    template<size_t I, VariantAccessPolicy Policy = VariantAccessPolicy::checked>
+    void validate_access() const {
+        if constexpr (Policy == VariantAccessPolicy::checked) {
+            if (index() != I) {
+                variant_detail::_Throw_bad_access(VariantAccessError::wrong_alternative);
+            }
+        }
+        else if constexpr (Policy == VariantAccessPolicy::asserting) {
+            assert(index() == I && "NanBoxedVariant::get: requested alternative is not active");
+        }
+        else {
+            variant_detail::_Assume(index() == I);
+        }
+    }
+
+public:
+    inline static constexpr std::size_t npos = -1;
+
+    inline static constexpr std::size_t alternatives_count = sizeof...(Types);
+
+    inline static constexpr bool never_valueless = true;
+
+    constexpr bool valueless_by_exception() const noexcept {
+        return false;
+    }
+
+    std::size_t index() const noexcept {
+        const std::uint64_t tag = _bits >> 48;
+        return tag >= _boxed_tag ? static_cast<std::size_t>(tag - _boxed_tag) : _double_index;
+    }
+
+    template<class Type>
+        requires meta_functions::_Is_type_present<Type, Types...>
+    bool holds_alternative() const noexcept {
+        return index() == meta_functions::_Get_index_v<Type, Types...>;
+    }
+
+    // Holds a value-initialized first alternative.
+    NanBoxedVariant() noexcept : _bits(_encode<0>(_Alternative<0>{})) {}
+
+    template<typename Type>
+        requires meta_functions::_Is_type_present<Type, Types...>
+    NanBoxedVariant(Type value) noexcept
+        : _bits(_encode<meta_functions::_Get_index_v<Type, Types...>>(value)) {}
+
+    template<typename Type>
+        requires meta_functions::_Is_type_present<Type, Types...>
+    explicit NanBoxedVariant(std::in_place_type_t<Type>, Type value = Type{}) noexcept
+        : _bits(_encode<meta_functions::_Get_index_v<Type, Types...>>(value)) {}
+
+    template<size_t I>
+        requires meta_functions::_Is_index_of_alternative<I, Types...>
+    explicit NanBoxedVariant(std::in_place_index_t<I>, _Alternative<I> value = _Alternative<I>{}) noexcept
+        : _bits(_encode<I>(value)) {}
+
+public:
+    template<typename Type>
+        requires meta_functions::_Is_type_present<Type, Types...>
+    Type emplace(Type value) noexcept {
+        _bits = _encode<meta_functions::_Get_index_v<Type, Types...>>(value);
+        return value;
+    }
+
+    template<std::size_t I>
+        requires meta_functions::_Is_index_of_alternative<I, Types...>
+    _Alternative<I> emplace(_Alternative<I> value) noexcept {
+        _bits = _encode<I>(value);
+        return value;
+    }
+
+    template<typename Type>
+        requires meta_functions::_Is_type_present<Type, Types...>
+    NanBoxedVariant& operator=(Type value) noexcept {
+        emplace<Type>(value);
+        return *this;
+    }
+
+    void swap(NanBoxedVariant& other) noexcept {
+        std::swap(_bits, other._bits);
+    }
+
+    // Compares the alternatives like Variant does, so 0.0 == -0.0 and a NaN
+    // is never equal to anything.
+    bool operator==(const NanBoxedVariant& other) const noexcept {
+        if (index() != other.index()) {
+            return false;
+        }
+        return visit([&other](auto value) {
+            using Type = decltype(value);
+            return value == other.template _decode<meta_functions::_Get_index_v<Type, Types...>>();
+        });
+    }
+
+public:
+    template <typename Type, VariantAccessPolicy Policy = VariantAccessPolicy::checked>
+        requires meta_functions::_Is_type_present<Type, Types...>
+    Type get() const {
+        constexpr std::size_t I = meta_functions::_Get_index_v<Type, Types...>;
+        validate_access<I, Policy>();
+        return _decode<I>();
+    }
+
+    template <size_t I, VariantAccessPolicy Policy = VariantAccessPolicy::checked>
+        requires meta_functions::_Is_index_of_alternative<I, Types...>
+    _Alternative<I> get() const {
+        validate_access<I, Policy>();
+        return _decode<I>();
+    }
+
+    template <typename Type>
+        requires meta_functions::_Is_type_present<Type, Types...>
+    Optional<Type> get_if() const noexcept {
+        return get_if<meta_functions::_Get_index_v<Type, Types...>>();
+    }
+
+    template <std::size_t I>
+        requires meta_functions::_Is_index_of_alternative<I, Types...>
+    Optional<_Alternative<I>> get_if() const noexcept {
+        if (index() != I) {
+            return std::nullopt;
+        }
+        return Optional<_Alternative<I>>(_decode<I>());
+    }
+
+public:
+    template<typename Visitor>
+    decltype(auto) visit(Visitor&& visitor) const {
+        using Result = std::invoke_result_t<Visitor, _Alternative<0>>;
+
+        static_assert((std::is_same_v<Result, std::invoke_result_t<Visitor, Types>> && ...),
+            "Visitor must return the same type for all alternatives");
+
+        return variant_detail::_Dispatch<sizeof...(Types), Result>(index(),
+            [](auto I, const NanBoxedVariant& self, Visitor&& target) -> Result {
+                return std::invoke(std::forward<Visitor>(target), self.template _decode<decltype(I)::value>());
+            }, *this, std::forward<Visitor>(visitor));
+    }
+};
+
+template<typename Visitor, typename... Types>
+decltype(auto) visit(Visitor&& visitor, const NanBoxedVariant<Types...>& variant) {
+    return variant.visit(std::forward<Visitor>(visitor));
+}
+
+// Free forms of the accessors, for code written against std::variant; get
+// returns the value and get_if an Optional of it, like the members do.
+template<typename Type, VariantAccessPolicy Policy = VariantAccessPolicy::checked, typename... Types>
+    requires meta_functions::_Is_type_present<Type, Types...>
+Type get(const NanBoxedVariant<Types...>& variant) {
+    return variant.template get<Type, Policy>();
+}
+
+template<std::size_t I, VariantAccessPolicy Policy = VariantAccessPolicy::checked, typename... Types>
+    requires meta_functions::_Is_index_of_alternative<I, Types...>
+meta_functions::_Get_type_t<I, Types...> get(const NanBoxedVariant<Types...>& variant) {
+    return variant.template get<I, Policy>();
+}
+
+template<typename Type, typename... Types>
+    requires meta_functions::_Is_type_present<Type, Types...>
+Optional<Type> get_if(const NanBoxedVariant<Types...>& variant) noexcept {
+    return variant.template get_if<Type>();
+}
+
+template<std::size_t I, typename... Types>
+    requires meta_functions::_Is_index_of_alternative<I, Types...>
+Optional<meta_functions::_Get_type_t<I, Types...>> get_if(const NanBoxedVariant<Types...>& variant) noexcept {
+    return variant.template get_if<I>();
+}
@@ -0,0 +1,267 @@
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include "Variant.hpp"
+
+
+namespace variant_detail {
+    // Takes the place of the engaged flag when a niche of the value marks
+    // the empty state.
+    struct _Niche_flag {};
+
+    [[noreturn]] inline void _Throw_bad_optional_access() {
+#ifdef VARIANT_NO_EXCEPTIONS
+        std::abort();
+#else
+        throw std::bad_optional_access();
+#endif
+    }
+}
+
+// An optional value that marks "empty" with a niche of Type (see
+// meta_functions::niche_traits) when Type has one, so it is no larger than
+// Type: Optional<Variant<...>> uses an index value the Variant never holds.
+// Other types get a flag after the value, as std::optional does. The niche
+// form needs Type to be nothrow move constructible, so that a throwing
+// construction can happen in a temporary and never leaves a half-written
+// niche field behind.
+template<typename Type>
+    requires std::is_object_v<Type> && (!std::is_array_v<Type>) && std::is_destructible_v<Type>
+class Optional final {
+private:
+    using _Niche = meta_functions::niche_traits<Type>;
+
+    inline static constexpr bool _uses_niche =
+        meta_functions::niche_count_v<Type> > 0 && std::is_nothrow_move_constructible_v<Type>;
+
+    using _Flag = std::conditional_t<_uses_niche, variant_detail::_Niche_flag, bool>;
+
+    alignas(Type) std::byte _buffer[sizeof(Type)];
+    VARIANT_NO_UNIQUE_ADDRESS _Flag _engaged{};
+
+    Type* _address() noexcept {
+        return std::launder(reinterpret_cast<Type*>(_buffer));
+    }
+
+    const Type* _address() const noexcept {
+        return std::launder(reinterpret_cast<const Type*>(_buffer));
+    }
+
+    void _mark_empty() noexcept {
+        if constexpr (_uses_niche) {
+            _Niche::store(_buffer + _Niche::offset, 0);
+        }
+        else {
+            _engaged = false;
+        }
+    }
+
+    // Expects the Optional to be empty.
+    template<typename... Args>
+    Type& _construct(Args&&... args) {
+        if constexpr (_uses_niche && !std::is_nothrow_constructible_v<Type, Args...>) {
+            Type temp(std::forward<Args>(args)...);
+            std::construct_at(reinterpret_cast<Type*>(_buffer), std::move(temp));
+        }
+        else {
+            std::construct_at(reinterpret_cast<Type*>(_buffer), std::forward<Args>(args)...);
+        }
+        if constexpr (!_uses_niche) {
+            _engaged = true;
+        }
+        return *_address();
+    }
+
+    template<typename Other>
+    void _assign(Other&& other) {
+        if (!other.has_value()) {
+            reset();
+        }
+        else if (has_value()) {
+            **this = *std::forward<Other>(other);
+        }
+        else {
+            _construct(*std::forward<Other>(other));
+        }
+    }
+
+public:
+    using value_type = Type;
+
+    Optional() noexcept {
+        _mark_empty();
+    }
+
+    Optional(std::nullopt_t) noexcept : Optional() {}
+
+    template<typename... Args>
+        requires std::is_constructible_v<Type, Args...>
+    explicit Optional(std::in_place_t, Args&&... args) : Optional() {
+        _construct(std::forward<Args>(args)...);
+    }
+
+    template<typename UType = Type>
+        requires std::is_constructible_v<Type, UType&&> &&
+                 (!std::is_same_v<std::remove_cvref_t<UType>, Optional>) &&
+                 (!std::is_same_v<std::remove_cvref_t<UType>, std::in_place_t>) &&
+                 (!std::is_same_v<std::remove_cvref_t<UType>, std::nullopt_t>)
+    Optional(UType&& value) : Optional() {
+        _construct(std::forward<UType>(value));
+    }
+
+    Optional(const Optional& other)
+        requires meta_functions::_All_copy_constructible<Type>&&
+                 meta_functions::_All_trivially_copy_constructible<Type> = default;
+
+    Optional(const Optional& other)
+        noexcept(std::is_nothrow_copy_constructible_v<Type>)
+        requires meta_functions::_All_copy_constructible<Type>
+    : Optional() {
+        if (other.has_value()) {
+            _construct(*other);
+        }
+    }
+
+    Optional(Optional&& other)
+        requires meta_functions::_All_move_constructible<Type>&&
+                 meta_functions::_All_trivially_move_constructible<Type> = default;
+
+    Optional(Optional&& other)
+        noexcept(std::is_nothrow_move_constructible_v<Type>)
+        requires meta_functions::_All_move_constructible<Type>
+    : Optional() {
+        if (other.has_value()) {
+            _construct(std::move(*other));
+        }
+    }
+
+    ~Optional()
+        requires meta_functions::_All_trivially_destructible<Type> = default;
+
+    ~Optional() {
+        reset();
+    }
+
+public:
+    Optional& operator=(const Optional& other)
+        requires meta_functions::_All_copy_constructible<Type>&&
+                 meta_functions::_All_copy_assignable<Type>&&
+                 meta_functions::_All_trivially_copy_assignable<Type> = default;
+
+    Optional& operator=(const Optional& other)
+        noexcept(std::is_nothrow_copy_constructible_v<Type> && std::is_nothrow_copy_assignable_v<Type>)
+        requires meta_functions::_All_copy_constructible<Type>&&
+                 meta_functions::_All_copy_assignable<Type>
+    {
+        if (this != std::addressof(other)) {
+            _assign(other);
+        }
+        return *this;
+    }
+
+    Optional& operator=(Optional&& other)
+        requires meta_functions::_All_move_constructible<Type>&&
+                 meta_functions::_All_move_assignable<Type>&&
+                 meta_functions::_All_trivially_move_assignable<Type> = default;
+
+    Optional& operator=(Optional&& other)
+        noexcept(std::is_nothrow_move_constructible_v<Type> && std::is_nothrow_move_assignable_v<Type>)
+        requires meta_functions::_All_move_constructible<Type>&&
+                 meta_functions::_All_move_assignable<Type>
+    {
+        if (this != std::addressof(other)) {
+            _assign(std::move(other));
+        }
+        return *this;
+    }
+
+    Optional& operator=(std::nullopt_t) noexcept {
+        reset();
+        return *this;
+    }
+
+public:
+    bool has_value() const noexcept {
+        if constexpr (_uses_niche) {
+            return _Niche::load(_buffer + _Niche::offset) != 0;
+        }
+        else {
+            return _engaged;
+        }
+    }
+
+    explicit operator bool() const noexcept {
+        return has_value();
+    }
+
+    // Destroys the value, if any, and constructs a new one from args. If that
+    // construction throws, the Optional is left empty.
+    template<typename... Args>
+        requires std::is_constructible_v<Type, Args...>
+    Type& emplace(Args&&... args) {
+        reset();
+        return _construct(std::forward<Args>(args)...);
+    }
+
+    void reset() noexcept {
+        if (has_value()) {
+            std::destroy_at(_address());
+            _mark_empty();
+        }
+    }
+
+public:
+    Type& value() & {
+        if (!has_value()) {
+            variant_detail::_Throw_bad_optional_access();
+        }
+        return *_address();
+    }
+
+    const Type& value() const& {
+        if (!has_value()) {
+            variant_detail::_Throw_bad_optional_access();
+        }
+        return *_address();
+    }
+
+    Type&& value() && {
+        return std::move(value());
+    }
+
+    const Type&& value() const&& {
+        return std::move(value());
+    }
+
+    Type& operator*() & noexcept {
+        assert(has_value() && "Optional: dereferencing an empty Optional");
+        return *_address();
+    }
+
+    const Type& operator*() const& noexcept {
+        assert(has_value() && "Optional: dereferencing an empty Optional");
+        return *_address();
+    }
+
+    Type&& operator*() && noexcept {
+        return std::move(**this);
+    }
+
+    const Type&& operator*() const&& noexcept {
+        return std::move(**this);
+    }
+
+    Type* operator->() noexcept {
+        return std::addressof(**this);
+    }
+
+    const Type* operator->() const noexcept {
+        return std::addressof(**this);
+    }
+};
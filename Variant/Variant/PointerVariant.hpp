@@ -0,0 +1,220 @@
+#pragma once
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include "../detail/Access.hpp"
+#include "../detail/Dispatch.hpp"
+#include "../../Auxiliary_meta_functions/Auxiliary_meta_functions/Auxiliary_meta_functions.hpp"
+
+
+namespace variant_detail {
+    template<typename Pointer>
+    constexpr std::size_t _Pointee_alignment() noexcept {
+        using Pointee = std::remove_cv_t<std::remove_pointer_t<Pointer>>;
+        if constexpr (std::is_void_v<Pointee> || std::is_function_v<Pointee>) {
+            return 1;
+        }
+        else {
+            return alignof(Pointee);
+        }
+    }
+}
+
+// A Variant of pointer types packed into one uintptr_t: the index of the
+// active alternative lives in the low bits that the pointees' alignment
+// keeps zero, so 2 alternatives need 2-byte aligned pointees, 3 or 4 need
+// 4-byte aligned ones, and so on. The alignment is checked where a pointer is
+// stored, so the pointees may still be incomplete where the PointerVariant
+// type is named, as in a tree node that points to its own type.
+// The surface follows Variant, except that get returns the pointer by value
+// and get_if returns the pointer itself, or nullptr if another alternative is
+// active: there is no pointer object to refer to. It is never valueless.
+template<typename... Types>
+    requires meta_functions::_Is_pack_of_different_type<Types...>&&
+             meta_functions::_Is_pack_not_empty<Types...>&&
+             (std::is_pointer_v<Types> && ...)
+class PointerVariant final {
+private:
+    template<size_t I>
+    using _Alternative = meta_functions::_Get_type_t<I, Types...>;
+
+    inline static constexpr std::uintptr_t _tag_mask =
+        (std::uintptr_t(1) << std::bit_width(sizeof...(Types) - 1)) - 1;
+
+    std::uintptr_t _bits = 0;
+
+    template<size_t I>
+    static std::uintptr_t _encode(_Alternative<I> pointer) noexcept {
+        static_assert(variant_detail::_Pointee_alignment<_Alternative<I>>() > _tag_mask,
+            "Pointee alignment leaves too few low bits for the index of this many alternatives");
+        const auto address = reinterpret_cast<std::uintptr_t>(pointer);
+        assert((address & _tag_mask) == 0 && "PointerVariant: pointer is less aligned than its type");
+        return address | I;
+    }
+
+    template<size_t I>
+    _Alternative<I> _decode() const noexcept {
+        return reinterpret_cast<_Alternative<I>>(_bits & ~_tag_mask);
+    }
+
+    template<size_t I, VariantAccessPolicy Policy = VariantAccessPolicy::checked>
+    void validate_access() const {
+        if constexpr (Policy == VariantAccessPolicy::checked) {
+            if (index() != I) {
+                variant_detail::_Throw_bad_access(VariantAccessError::wrong_alternative);
+            }
+        }
+        else if constexpr (Policy == VariantAccessPolicy::asserting) {
+            assert(index() == I && "PointerVariant::get: requested alternative is not active");
+        }
+        else {
+            variant_detail::_Assume(index() == I);
+        }
+    }
+
+public:
+    inline static constexpr std::size_t npos = -1;
+
+    inline static constexpr std::size_t alternatives_count = sizeof...(Types);
+
+    inline static constexpr bool never_valueless = true;
+
+    constexpr bool valueless_by_exception() const noexcept {
+        return false;
+    }
+
+    std::size_t index() const noexcept {
+        return static_cast<std::size_t>(_bits & _tag_mask);
+    }
+
+    template<class Type>
+        requires meta_functions::_Is_type_present<Type, Types...>
+    bool holds_alternative() const noexcept {
+        return index() == meta_functions::_Get_index_v<Type, Types...>;
+    }
+
+    // Holds a null pointer of the first alternative.
+    PointerVariant() noexcept = default;
+
+    template<typename Type>
+        requires meta_functions::_Is_type_present<Type, Types...>
+    PointerVariant(Type pointer) noexcept
+        : _bits(_encode<meta_functions::_Get_index_v<Type, Types...>>(pointer)) {}
+
+    template<typename Type>
+        requires meta_functions::_Is_type_present<Type, Types...>
+    explicit PointerVariant(std::in_place_type_t<Type>, Type pointer = nullptr) noexcept
+        : _bits(_encode<meta_functions::_Get_index_v<Type, Types...>>(pointer)) {}
+
+    template<size_t I>
+        requires meta_functions::_Is_index_of_alternative<I, Types...>
+    explicit PointerVariant(std::in_place_index_t<I>, _Alternative<I> pointer = nullptr) noexcept
+        : _bits(_encode<I>(pointer)) {}
+
+public:
+    template<typename Type>
+        requires meta_functions::_Is_type_present<Type, Types...>
+    Type emplace(Type pointer) noexcept {
+        _bits = _encode<meta_functions::_Get_index_v<Type, Types...>>(pointer);
+        return pointer;
+    }
+
+    template<std::size_t I>
+        requires meta_functions::_Is_index_of_alternative<I, Types...>
+    _Alternative<I> emplace(_Alternative<I> pointer) noexcept {
+        _bits = _encode<I>(pointer);
+        return pointer;
+    }
+
+    template<typename Type>
+        requires meta_functions::_Is_type_present<Type, Types...>
+    PointerVariant& operator=(Type pointer) noexcept {
+        emplace<Type>(pointer);
+        return *this;
+    }
+
+    void swap(PointerVariant& other) noexcept {
+        std::swap(_bits, other._bits);
+    }
+
+    bool operator==(const PointerVariant& other) const noexcept = default;
+
+public:
+    template <typename Type, VariantAccessPolicy Policy = VariantAccessPolicy::checked>
+        requires meta_functions::_Is_type_present<Type, Types...>
+    Type get() const {
+        constexpr std::size_t I = meta_functions::_Get_index_v<Type, Types...>;
+        validate_access<I, Policy>();
+        return _decode<I>();
+    }
+
+    template <size_t I, VariantAccessPolicy Policy = VariantAccessPolicy::checked>
+        requires meta_functions::_Is_index_of_alternative<I, Types...>
+    _Alternative<I> get() const {
+        validate_access<I, Policy>();
+        return _decode<I>();
+    }
+
+    template <typename Type>
+        requires meta_functions::_Is_type_present<Type, Types...>
+    Type get_if() const noexcept {
+        return holds_alternative<Type>()
+            ? _decode<meta_functions::_Get_index_v<Type, Types...>>()
+            : nullptr;
+    }
+
+    template <std::size_t I>
+        requires meta_functions::_Is_index_of_alternative<I, Types...>
+    _Alternative<I> get_if() const noexcept {
+        return index() == I ? _decode<I>() : nullptr;
+    }
+
+public:
+    template<typename Visitor>
+    decltype(auto) visit(Visitor&& visitor) const {
+        using Result = std::invoke_result_t<Visitor, _Alternative<0>>;
+
+        static_assert((std::is_same_v<Result, std::invoke_result_t<Visitor, Types>> && ...),
+            "Visitor must return the same type for all alternatives");
+
+        return variant_detail::_Dispatch<sizeof...(Types), Result>(index(),
+            [](auto I, const PointerVariant& self, Visitor&& target) -> Result {
+                return std::invoke(std::forward<Visitor>(target), self.template _decode<decltype(I)::value>());
+            }, *this, std::forward<Visitor>(visitor));
+    }
+};
+
+template<typename Visitor, typename... Types>
+decltype(auto) visit(Visitor&& visitor, const PointerVariant<Types...>& variant) {
+    return variant.visit(std::forward<Visitor>(visitor));
+}
+
+// Free forms of the accessors, for code written against std::variant; they
+// return the pointer by value like the members do.
+template<typename Type, VariantAccessPolicy Policy = VariantAccessPolicy::checked, typename... Types>
+    requires meta_functions::_Is_type_present<Type, Types...>
+Type get(const PointerVariant<Types...>& variant) {
+    return variant.template get<Type, Policy>();
+}
+
+template<std::size_t I, VariantAccessPolicy Policy = VariantAccessPolicy::checked, typename... Types>
+    requires meta_functions::_Is_index_of_alternative<I, Types...>
+meta_functions::_Get_type_t<I, Types...> get(const PointerVariant<Types...>& variant) {
+    return variant.template get<I, Policy>();
+}
+
+template<typename Type, typename... Types>
+    requires meta_functions::_Is_type_present<Type, Types...>
+Type get_if(const PointerVariant<Types...>& variant) noexcept {
+    return variant.template get_if<Type>();
+}
+
+template<std::size_t I, typename... Types>
+    requires meta_functions::_Is_index_of_alternative<I, Types...>
+meta_functions::_Get_type_t<I, Types...> get_if(const PointerVariant<Types...>& variant) noexcept {
+    return variant.template get_if<I>();
+}
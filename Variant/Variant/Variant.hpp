@@ -1,217 +1,645 @@
+#pragma once
+#include <cassert>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <tuple>
 #include <type_traits>
 #include <variant>
+#include "../detail/Access.hpp"
+#include "../detail/Allocator.hpp"
+#include "../detail/Dispatch.hpp"
+#include "../detail/Layout.hpp"
+#include "../detail/Relocation.hpp"
+#include "Boxed.hpp"
+#include "../../VariadicUnion/VariadicUnion/FlatStorage.hpp"
+#include "../../VariadicUnion/VariadicUnion/NicheStorage.hpp"
+#include "../../VariadicUnion/VariadicUnion/PackedStorage.hpp"
 #include "../../VariadicUnion/VariadicUnion/VariadicUnion.hpp"
 #include "../../Auxiliary_meta_functions/Auxiliary_meta_functions/Auxiliary_meta_functions.hpp"
 
+#if defined(_MSC_VER) && !defined(__clang__)
+#define VARIANT_NO_UNIQUE_ADDRESS [[msvc::no_unique_address]]
+#else
+#define VARIANT_NO_UNIQUE_ADDRESS [[no_unique_address]]
+#endif
+
+namespace variant_detail {
+    struct _Variant_access;
+
+    // Packs larger than this keep their alternatives in FlatStorage, whose
+    // accessors do not recurse over the pack at run time. Smaller ones keep
+    // VariadicUnion. Both work in constant expressions.
+    inline constexpr std::size_t _Flat_storage_threshold = 16;
+
+    template<typename... Types>
+    using _Union_storage_t = std::conditional_t<(sizeof...(Types) > _Flat_storage_threshold),
+        FlatStorage<Types...>, VariadicUnion<Types...>>;
+
+    // A moved-from Boxed owns no value, so a Variant moved from while holding
+    // one has nothing left to read and becomes valueless. Packs of other
+    // nothrow move constructible alternatives never are.
+    template<typename... Types>
+    inline constexpr bool _Never_valueless_v =
+        ((std::is_nothrow_move_constructible_v<Types> && !_Is_boxed_v<Types>) && ...);
+
+    template<typename Storage, typename Index>
+    struct _Tagged_layout {
+        Storage storage;
+        Index index;
+    };
+
+    // Packs opted in with meta_functions::enable_compact_layout whose
+    // alternatives have spare bit patterns to hold the index (see
+    // meta_functions::niche_traits) keep it inside NicheStorage. Only
+    // never-valueless packs qualify: a throwing construction of the dataful
+    // alternative could leave a valid-looking niche field behind. Otherwise
+    // opted-in packs use PackedStorage when it is smaller than the union plus
+    // an index member. Everything else keeps the union, which works in
+    // constant expressions.
+    template<typename... Types>
+    constexpr VariantLayoutKind _Select_layout() noexcept {
+        if constexpr (!meta_functions::enable_compact_layout_v<Types...>) {
+            return VariantLayoutKind::tagged;
+        }
+        else {
+            if constexpr (((meta_functions::niche_count_v<Types> > 0) || ...) &&
+                          _Never_valueless_v<Types...>) {
+                if (NicheStorage<Types...>::is_viable) {
+                    return VariantLayoutKind::niche;
+                }
+            }
+            using Tagged = _Tagged_layout<_Union_storage_t<Types...>,
+                meta_functions::_Index_type_t<sizeof...(Types)>>;
+            return sizeof(PackedStorage<Types...>) < sizeof(Tagged)
+                ? VariantLayoutKind::packed
+                : VariantLayoutKind::tagged;
+        }
+    }
+
+    template<typename... Types>
+    inline constexpr VariantLayoutKind _Layout_kind_v = _Select_layout<Types...>();
+
+    template<typename... Types>
+    using _Storage_t = std::conditional_t<_Layout_kind_v<Types...> == VariantLayoutKind::niche,
+        NicheStorage<Types...>,
+        std::conditional_t<_Layout_kind_v<Types...> == VariantLayoutKind::packed,
+            PackedStorage<Types...>, _Union_storage_t<Types...>>>;
+
+    // Byte offset and size of the index: reported by a storage that keeps it,
+    // otherwise those of the member following Storage.
+    template<typename Storage, typename Index, bool Embedded>
+    constexpr std::size_t _Index_offset() noexcept {
+        if constexpr (Embedded) {
+            return Storage::index_offset;
+        }
+        else {
+            return (sizeof(Storage) + alignof(Index) - 1) / alignof(Index) * alignof(Index);
+        }
+    }
+
+    template<typename Storage, typename Index, bool Embedded>
+    constexpr std::size_t _Index_size() noexcept {
+        if constexpr (Embedded) {
+            return Storage::index_size;
+        }
+        else {
+            return sizeof(Index);
+        }
+    }
+
+    // Takes the place of the index member when the storage records the index.
+    struct _Embedded_index {
+        constexpr explicit _Embedded_index(std::size_t) noexcept {}
+    };
+
+    // Niches of a separate index of type Index at byte Offset: the values
+    // between the last of Alternatives and the valueless index. The valueless
+    // index itself is excluded, a live Variant can hold it.
+    template<typename Index, std::size_t Offset, std::size_t Alternatives>
+    struct _Index_niche_traits {
+        static constexpr std::size_t offset = Offset;
+        static constexpr std::size_t size = sizeof(Index);
+        static constexpr std::size_t count = static_cast<Index>(-1) - Alternatives;
+
+        static void store(std::byte* field, std::size_t niche) noexcept {
+            const Index index = static_cast<Index>(Alternatives + niche);
+            std::memcpy(field, &index, sizeof(index));
+        }
+
+        static std::size_t load(const std::byte* field) noexcept {
+            Index index;
+            std::memcpy(&index, field, sizeof(index));
+            return index >= Alternatives && index != static_cast<Index>(-1)
+                ? static_cast<std::size_t>(index - Alternatives)
+                : count;
+        }
+    };
+}
 
 template<typename... Types>
     requires meta_functions::_Is_pack_of_different_type<Types...>&&
              meta_functions::_Is_pack_not_empty<Types...>
 class Variant final {
 private:
-    VariadicUnion<Types...> _storage;
-    size_t _index = -1;
+    friend struct variant_detail::_Variant_access;
+
+    template<typename>
+    friend struct meta_functions::niche_traits;
 
+    // What the storage holds for the I-th alternative: the alternative
+    // itself, or the Boxed that owns it.
     template<size_t I>
-    constexpr void validate_access() const {
-        if (valueless_by_exception()) {
-            throw std::bad_variant_access();
+    using _Stored = meta_functions::_Get_type_t<I, Types...>;
+
+    template<size_t I>
+    using _Alternative = variant_detail::_Unboxed_t<_Stored<I>>;
+
+    template<typename Type>
+    inline static constexpr std::size_t _index_of =
+        meta_functions::_Get_index_v<Type, variant_detail::_Unboxed_t<Types>...>;
+
+    template<typename Type>
+    inline static constexpr bool _is_alternative =
+        meta_functions::_Is_type_present<Type, variant_detail::_Unboxed_t<Types>...>;
+
+    using _Allocator = variant_detail::_Common_allocator_t<variant_detail::_Unboxed_t<Types>...>;
+
+    inline static constexpr bool _allocator_aware =
+        !std::is_same_v<_Allocator, variant_detail::_No_allocator>;
+
+    // A boxed alternative is built in a new box unless args already are one.
+    template<size_t I, typename... Args>
+    inline static constexpr bool _in_new_box = variant_detail::_Is_boxed_v<_Stored<I>> &&
+        !(sizeof...(Args) == 1 && (std::is_same_v<std::remove_cvref_t<Args>, _Stored<I>> && ...));
+
+    // Alternatives that take the Variant's allocator get it by uses-allocator
+    // construction, unless args are a whole box to copy or move.
+    template<size_t I, typename... Args>
+    inline static constexpr bool _uses_allocator =
+        _allocator_aware && std::uses_allocator_v<_Alternative<I>, _Allocator> &&
+        (!variant_detail::_Is_boxed_v<_Stored<I>> || _in_new_box<I, Args...>);
+
+    template<size_t I, typename... Args>
+    inline static constexpr bool _is_nothrow_creatable = _in_new_box<I, Args...>
+        ? std::is_nothrow_constructible_v<_Stored<I>, std::in_place_t, Args...>
+        : _uses_allocator<I, Args...>
+            ? variant_detail::_Is_nothrow_uses_allocator_constructible_v<_Stored<I>, _Allocator, Args...>
+            : std::is_nothrow_constructible_v<_Stored<I>, Args...>;
+
+    inline static constexpr bool _nothrow_movable = (std::is_nothrow_move_constructible_v<Types> && ...);
+
+    // Calls construct with the arguments that build the I-th alternative from
+    // args, the allocator added to them when the alternative takes it.
+    template<size_t I, typename Construct, typename... Args>
+    static constexpr decltype(auto) _with_allocator(Construct&& construct,
+        const _Allocator& allocator, Args&&... args) {
+        if constexpr (_uses_allocator<I, Args...>) {
+            return std::apply(std::forward<Construct>(construct),
+                std::uses_allocator_construction_args<_Alternative<I>>(allocator, std::forward<Args>(args)...));
         }
-        if (_index != I) {
-            throw std::bad_variant_access();
+        else {
+            return std::forward<Construct>(construct)(std::forward<Args>(args)...);
         }
     }
 
-    template<size_t isNoexcept, typename Type>
-    constexpr void variant_assign(bool isSameType, size_t otherIndex, Type&& src)
-        noexcept(isNoexcept) {
-        using Pure_type = std::remove_cvref_t<Type>;
-        if (isSameType) {
-            if constexpr (isNoexcept) {
-                _storage.get<Pure_type>() = std::forward<Type>(src);
+    template<size_t I, typename Storage, typename... Args>
+    static constexpr void _create(Storage& storage, const _Allocator& allocator, Args&&... args) {
+        _with_allocator<I>([&storage]<typename... Final>(Final&&... final_args) {
+            if constexpr (_in_new_box<I, Final...>) {
+                storage.template create<_Stored<I>>(std::in_place, std::forward<Final>(final_args)...);
             }
             else {
-                try {
-                    _storage.get<Pure_type>() = std::forward<Type>(src);
-                }
-                catch (...) {
-                    _index = npos;
-                    throw;
-                }
+                storage.template create<_Stored<I>>(std::forward<Final>(final_args)...);
+            }
+        }, allocator, std::forward<Args>(args)...);
+    }
 
+    template<size_t I, typename... Args>
+    static constexpr _Stored<I> _make(const _Allocator& allocator, Args&&... args) {
+        return _with_allocator<I>([]<typename... Final>(Final&&... final_args) -> _Stored<I> {
+            if constexpr (_in_new_box<I, Final...>) {
+                return _Stored<I>(std::in_place, std::forward<Final>(final_args)...);
             }
+            else {
+                return _Stored<I>(std::forward<Final>(final_args)...);
+            }
+        }, allocator, std::forward<Args>(args)...);
+    }
+
+    template<size_t I, typename Storage>
+    static constexpr auto& _get(Storage& storage) noexcept {
+        return variant_detail::_Unbox(storage.template get<_Stored<I>>());
+    }
+
+    using _Index_type = meta_functions::_Index_type_t<sizeof...(Types)>;
+
+    inline static constexpr _Index_type _valueless_index = static_cast<_Index_type>(-1);
+
+    using _Storage = variant_detail::_Storage_t<Types...>;
+
+    inline static constexpr VariantLayoutKind _layout_kind = variant_detail::_Layout_kind_v<Types...>;
+
+    inline static constexpr bool _embedded_index = _layout_kind != VariantLayoutKind::tagged;
+
+    using _Index_field = std::conditional_t<_embedded_index,
+        variant_detail::_Embedded_index, _Index_type>;
+
+    _Storage _storage;
+    VARIANT_NO_UNIQUE_ADDRESS _Index_field _index = _Index_field(_valueless_index);
+    VARIANT_NO_UNIQUE_ADDRESS _Allocator _allocator = _Allocator();
+
+    inline static constexpr std::size_t _index_offset =
+        variant_detail::_Index_offset<_Storage, _Index_type, _embedded_index>();
+
+    inline static constexpr std::size_t _index_size =
+        variant_detail::_Index_size<_Storage, _Index_type, _embedded_index>();
+
+    constexpr _Index_type _get_index() const noexcept {
+        if constexpr (_embedded_index) {
+            return static_cast<_Index_type>(_storage.index());
+        }
+        else {
+            return _index;
+        }
+    }
+
+    // Called after the alternative is constructed: the niche layout may
+    // derive the index from the constructed object itself.
+    constexpr void _set_index(std::size_t index) noexcept {
+        if constexpr (_embedded_index) {
+            _storage.set_index(index);
+        }
+        else {
+            _index = static_cast<_Index_type>(index);
+        }
+    }
+
+    constexpr VariantAccessError _access_error() const noexcept {
+        return valueless_by_exception()
+            ? VariantAccessError::valueless
+            : VariantAccessError::wrong_alternative;
+    }
+
+    // The valueless index never equals I, so one comparison covers both
+    // failures.
+    template<size_t I, VariantAccessPolicy Policy = VariantAccessPolicy::checked>
+    constexpr void validate_access() const {
+        if constexpr (Policy == VariantAccessPolicy::checked) {
+            if (_get_index() != I) {
+                variant_detail::_Throw_bad_access(_access_error());
+            }
+        }
+        else if constexpr (Policy == VariantAccessPolicy::asserting) {
+            assert(_get_index() == I && "Variant::get: requested alternative is not active");
+        }
+        else {
+            variant_detail::_Assume(_get_index() == I);
+        }
+    }
+
+    constexpr void _destroy_active() noexcept {
+        if (!valueless_by_exception()) {
+            variant_detail::_Dispatch<sizeof...(Types), void>(_get_index(),
+                [](auto I, _Storage& storage) {
+                    storage.template destroy<_Stored<decltype(I)::value>>();
+                }, _storage);
+        }
+    }
+
+    // Destroys the active alternative and constructs the I-th one from args.
+    // A Variant of nothrow move constructible alternatives whose new
+    // alternative may throw on construction builds it in a temporary first
+    // and moves it in, so the exception leaves the Variant unchanged.
+    template<size_t I, typename... Args>
+    constexpr _Alternative<I>& _replace(Args&&... args) {
+        if constexpr (_is_nothrow_creatable<I, Args...>) {
+            _destroy_active();
+            _create<I>(_storage, _allocator, std::forward<Args>(args)...);
+        }
+        else if constexpr (_nothrow_movable) {
+            _Stored<I> temp = _make<I>(_allocator, std::forward<Args>(args)...);
+            _destroy_active();
+            _storage.template create<_Stored<I>>(std::move(temp));
         }
         else {
-            ((meta_functions::_Get_index_v<Types, Types...> == _index ?
-                _storage.destroy<Types>()
-                : void()), ...);
-            _index = otherIndex;
-            if constexpr (isNoexcept) {
-                _storage.create<Pure_type>(std::forward<Type>(src));
+            _destroy_active();
+            _set_index(_valueless_index);
+            _create<I>(_storage, _allocator, std::forward<Args>(args)...);
+        }
+        _set_index(I);
+        return _get<I>(_storage);
+    }
+
+    // Assigns to the I-th alternative in place if it is already active,
+    // otherwise replaces the active one with the I-th constructed from src.
+    template<size_t I, bool isNoexcept, typename Type>
+    constexpr void variant_assign(Type&& src) noexcept(isNoexcept) {
+        using Pure_type = _Stored<I>;
+        if (_get_index() == I) {
+            if constexpr (isNoexcept || _nothrow_movable) {
+                _storage.template get<Pure_type>() = std::forward<Type>(src);
             }
             else {
-                try {
-                    _storage.create<Pure_type>(std::forward<Type>(src));
-                }
-                catch (...) {
-                    _index = npos;
-                    throw;
-                }
+                // Stays valueless if the assignment throws.
+                _set_index(_valueless_index);
+                _storage.template get<Pure_type>() = std::forward<Type>(src);
+                _set_index(I);
             }
+            return;
         }
-    }
 
-    template<typename Type, typename Creator>
-    constexpr Type& _emplace_impl(std::size_t new_index, Creator&& creator) {
-        ((meta_functions::_Get_index_v<Types, Types...> == _index ?
-            _storage.destroy<Types>() : void()), ...);
+        _replace<I>(std::forward<Type>(src));
+    }
 
-        _index = new_index;
+    // Swapping two alternatives in place would swap the allocators they hold.
+    constexpr bool _same_allocator(const Variant& other) const noexcept {
+        if constexpr (_allocator_aware) {
+            return _allocator == other._allocator;
+        }
+        else {
+            return true;
+        }
+    }
 
-        try {
-            std::forward<Creator>(creator)();
+    // Builds a copy of the alternative active in other, or moves it when
+    // Source is an rvalue, with this Variant's allocator.
+    template<typename Source>
+    constexpr void _construct_from(Source&& other) {
+        if (!other.valueless_by_exception()) {
+            variant_detail::_Dispatch<sizeof...(Types), void>(other._get_index(),
+                [](auto I, Variant& self, Source&& source) {
+                    _create<decltype(I)::value>(self._storage, self._allocator,
+                        variant_detail::_Forward_like<Source>(
+                            source._storage.template get<_Stored<decltype(I)::value>>()));
+                }, *this, std::forward<Source>(other));
         }
-        catch (...) {
-            _index = npos;
-            throw;
+        _set_index(other._get_index());
+    }
+
+    template<typename Self, typename Visitor>
+    static constexpr decltype(auto) _visit_impl(Self&& self, Visitor&& visitor) {
+        using Result = std::invoke_result_t<Visitor,
+            decltype(variant_detail::_Forward_like<Self>(_get<0>(self._storage)))>;
+
+        static_assert((std::is_same_v<Result, std::invoke_result_t<Visitor,
+            decltype(variant_detail::_Forward_like<Self>(
+                variant_detail::_Unbox(self._storage.template get<Types>())))>> && ...),
+            "Visitor must return the same type for all alternatives");
+
+        if (self.valueless_by_exception()) {
+            variant_detail::_Throw_bad_access(VariantAccessError::valueless);
         }
 
-        return _storage.get<Type>();
+        return variant_detail::_Dispatch<sizeof...(Types), Result>(self._get_index(),
+            [](auto I, Self&& source, Visitor&& target) -> Result {
+                return std::invoke(std::forward<Visitor>(target),
+                    variant_detail::_Forward_like<Self>(_get<decltype(I)::value>(source._storage)));
+            }, std::forward<Self>(self), std::forward<Visitor>(visitor));
     }
 
 public:
     inline static constexpr std::size_t npos = -1;
 
+    inline static constexpr std::size_t alternatives_count = sizeof...(Types);
+
+    // The allocator_type of the first alternative that has one. Without such
+    // an alternative it is variant_detail::_No_allocator, which no allocator
+    // converts to, so std::uses_allocator is false for the Variant.
+    using allocator_type = _Allocator;
+
+    // True when every alternative is nothrow move constructible and none is
+    // Boxed: a throwing construction then happens in a temporary, and a
+    // moved-from Variant keeps its moved-from alternative, so the Variant is
+    // never valueless. Boxed alternatives keep the first part, but a Variant
+    // moved from becomes valueless, as the moved-from box holds no value.
+    inline static constexpr bool never_valueless = variant_detail::_Never_valueless_v<Types...>;
+
     constexpr bool valueless_by_exception() const noexcept {
-        return _index == npos;
+        if constexpr (never_valueless) {
+            return false;
+        }
+        else {
+            return _get_index() == _valueless_index;
+        }
     }
 
     constexpr size_t index() const noexcept {
-        return _index;
+        return valueless_by_exception() ? npos : _get_index();
     }
 
     template<class Type>
-        requires meta_functions::_Is_type_present<Type, Types...>
+        requires _is_alternative<Type>
     constexpr bool holds_alternative() const noexcept {
-        return meta_functions::_Get_index_v<Type, Types...> == _index;
+        return _index_of<Type> == _get_index();
     }
 
     constexpr Variant()
-        noexcept(std::is_nothrow_default_constructible_v<
-            meta_functions::_Get_first_t<Types...>>)
-        : _index(0), _storage() {
-        static_assert(meta_functions::_First_type_default_constructible<Types...>,
+        noexcept(_is_nothrow_creatable<0>)
+        : _storage() {
+        static_assert(meta_functions::_First_type_default_constructible<_Alternative<0>>,
             "First type haven't default constructor");
-        _storage.create<meta_functions::_Get_first_t<Types...>>();
+        _create<0>(_storage, _allocator);
+        _set_index(0);
     }
 
+    constexpr Variant(const Variant& other)
+        requires meta_functions::_All_copy_constructible<Types...>&&
+                 meta_functions::_All_trivially_copy_constructible<Types...> = default;
+
     constexpr Variant(const Variant& other)
         noexcept((std::is_nothrow_copy_constructible_v<Types> && ...))
         requires meta_functions::_All_copy_constructible<Types...>
-    : _index(other._index), _storage() {
-        ((meta_functions::_Get_index_v<Types, Types...> == _index ?
-            _storage.create<Types>(
-                other._storage.get<Types>())
-            : void()), ...);
+    : _storage(), _allocator(variant_detail::_Select_on_copy(other._allocator)) {
+        _construct_from(other);
     }
 
+    constexpr Variant(Variant&& other)
+        requires meta_functions::_All_move_constructible<Types...>&&
+                 meta_functions::_All_trivially_move_constructible<Types...> = default;
+
     constexpr Variant(Variant&& other)
         noexcept((std::is_nothrow_move_constructible_v<Types> && ...))
         requires meta_functions::_All_move_constructible<Types...>
-    : _index(other._index), _storage() {
-        ((meta_functions::_Get_index_v<Types, Types...> == _index ?
-            _storage.create<Types>(
-                std::move(other._storage.get<Types>()))
-            : void()), ...);
-        other._index = npos;
+    : _storage(), _allocator(std::move(other._allocator)) {
+        if (!other.valueless_by_exception()) {
+            variant_detail::_Dispatch<sizeof...(Types), void>(other._get_index(),
+                [](auto I, _Storage& storage, _Storage& source) {
+                    using Type = _Stored<decltype(I)::value>;
+                    storage.template create<Type>(std::move(source.template get<Type>()));
+                }, _storage, other._storage);
+        }
+        _set_index(other._get_index());
+        if constexpr (!never_valueless) {
+            other._destroy_active();
+            other._set_index(_valueless_index);
+        }
     }
 
     template<typename Type>
-        requires meta_functions::_Is_type_present<std::remove_cvref_t<Type>, Types...>&&
+        requires _is_alternative<std::remove_cvref_t<Type>>&&
     std::is_constructible_v<std::remove_cvref_t<Type>, Type>
         constexpr Variant(Type&& value)
-        noexcept(std::is_nothrow_constructible_v<std::remove_cvref_t<Type>, Type>)
-        : _index(meta_functions::_Get_index_v<std::remove_cvref_t<Type>, Types...>), _storage() {
-        using Pure_type = std::remove_cvref_t<Type>;
-        _storage.create<Pure_type>(std::forward<Type>(value));
+        noexcept(_is_nothrow_creatable<_index_of<std::remove_cvref_t<Type>>, Type>)
+        : _storage() {
+        constexpr size_t index = _index_of<std::remove_cvref_t<Type>>;
+        _create<index>(_storage, _allocator, std::forward<Type>(value));
+        _set_index(index);
     }
 
     template<typename Type, typename... Args>
-        requires meta_functions::_Is_type_present<Type, Types...>&&
+        requires _is_alternative<Type>&&
     meta_functions::_Is_constructible_from_args<Type, Args...>
         constexpr explicit Variant(std::in_place_type_t<Type>, Args&&... args)
-        : _index(meta_functions::_Get_index_v<Type, Types...>), _storage() {
-        _storage.create<Type>(std::forward<Args>(args)...);
+        : _storage() {
+        _create<_index_of<Type>>(_storage, _allocator, std::forward<Args>(args)...);
+        _set_index(_index_of<Type>);
     }
 
     template<typename Type, typename UType, typename... Args>
-        requires meta_functions::_Is_type_present<Type, Types...>&&
+        requires _is_alternative<Type>&&
     meta_functions::_Is_constructible_from_init_list<Type, UType, Args...>
         constexpr explicit Variant(std::in_place_type_t<Type>, std::initializer_list<UType> il, Args&&... args)
-        : _index(meta_functions::_Get_index_v<Type, Types...>), _storage() {
-        _storage.create<Type>(il, std::forward<Args>(args)...);
+        : _storage() {
+        _create<_index_of<Type>>(_storage, _allocator, il, std::forward<Args>(args)...);
+        _set_index(_index_of<Type>);
     }
 
     template<size_t I, typename... Args>
-        requires meta_functions::_Is_type_present<meta_functions::_Get_type_t<I, Types...>, Types...>&&
-    meta_functions::_Is_constructible_from_args< meta_functions::_Get_type_t<I, Types...>, Args...>
+        requires meta_functions::_Is_index_of_alternative<I, Types...>&&
+    meta_functions::_Is_constructible_from_args<_Alternative<I>, Args...>
         constexpr explicit Variant(std::in_place_index_t<I>, Args&&... args)
-        : _index(I), _storage() {
-        using Type = meta_functions::_Get_type_t<I, Types...>;
-        _storage.create<Type>(std::forward<Args>(args)...);
+        : _storage() {
+        _create<I>(_storage, _allocator, std::forward<Args>(args)...);
+        _set_index(I);
     }
 
     template<size_t I, typename UType, typename... Args>
-        requires meta_functions::_Is_type_present<meta_functions::_Get_type_t<I, Types...>, Types...>&&
-    meta_functions::_Is_constructible_from_init_list<meta_functions::_Get_type_t<I, Types...>, UType, Args...>
+        requires meta_functions::_Is_index_of_alternative<I, Types...>&&
+    meta_functions::_Is_constructible_from_init_list<_Alternative<I>, UType, Args...>
         constexpr explicit Variant(std::in_place_index_t<I>, std::initializer_list<UType> il, Args&&... args)
-        : _index(I), _storage() {
-        using Type = meta_functions::_Get_type_t<I, Types...>;
-        _storage.create<Type>(il, std::forward<Args>(args)...);
+        : _storage() {
+        _create<I>(_storage, _allocator, il, std::forward<Args>(args)...);
+        _set_index(I);
     }
 
-    constexpr ~Variant() {
-        if (!valueless_by_exception()) {
-            ((meta_functions::_Get_index_v<Types, Types...> == _index
-                ? _storage.destroy<Types>() : void()), ...);
+    // Allocator-extended constructors, for Variants with an allocator_type.
+    // Every alternative that takes the allocator is built with it, now and on
+    // later emplace and assignment. Like the std::pmr containers, a Variant
+    // keeps its allocator for life: assignment and swap do not propagate it.
+    constexpr Variant(std::allocator_arg_t, const allocator_type& allocator)
+        requires _allocator_aware && meta_functions::_First_type_default_constructible<_Alternative<0>>
+        : _storage(), _allocator(allocator) {
+        _create<0>(_storage, _allocator);
+        _set_index(0);
+    }
+
+    constexpr Variant(std::allocator_arg_t, const allocator_type& allocator, const Variant& other)
+        requires _allocator_aware && meta_functions::_All_copy_constructible<Types...>
+        : _storage(), _allocator(allocator) {
+        _construct_from(other);
+    }
+
+    constexpr Variant(std::allocator_arg_t, const allocator_type& allocator, Variant&& other)
+        requires _allocator_aware && meta_functions::_All_move_constructible<Types...>
+        : _storage(), _allocator(allocator) {
+        _construct_from(std::move(other));
+        if constexpr (!never_valueless) {
+            other._destroy_active();
+            other._set_index(_valueless_index);
         }
     }
 
+    template<typename Type>
+        requires _allocator_aware && _is_alternative<std::remove_cvref_t<Type>>&&
+                 std::is_constructible_v<std::remove_cvref_t<Type>, Type>
+    constexpr Variant(std::allocator_arg_t, const allocator_type& allocator, Type&& value)
+        : _storage(), _allocator(allocator) {
+        constexpr size_t index = _index_of<std::remove_cvref_t<Type>>;
+        _create<index>(_storage, _allocator, std::forward<Type>(value));
+        _set_index(index);
+    }
+
+    template<typename Type, typename... Args>
+        requires _allocator_aware && _is_alternative<Type>&&
+                 meta_functions::_Is_constructible_from_args<Type, Args...>
+    constexpr explicit Variant(std::allocator_arg_t, const allocator_type& allocator,
+        std::in_place_type_t<Type>, Args&&... args)
+        : _storage(), _allocator(allocator) {
+        _create<_index_of<Type>>(_storage, _allocator, std::forward<Args>(args)...);
+        _set_index(_index_of<Type>);
+    }
+
+    template<typename Type, typename UType, typename... Args>
+        requires _allocator_aware && _is_alternative<Type>&&
+                 meta_functions::_Is_constructible_from_init_list<Type, UType, Args...>
+    constexpr explicit Variant(std::allocator_arg_t, const allocator_type& allocator,
+        std::in_place_type_t<Type>, std::initializer_list<UType> il, Args&&... args)
+        : _storage(), _allocator(allocator) {
+        _create<_index_of<Type>>(_storage, _allocator, il, std::forward<Args>(args)...);
+        _set_index(_index_of<Type>);
+    }
+
+    template<size_t I, typename... Args>
+        requires _allocator_aware && meta_functions::_Is_index_of_alternative<I, Types...>&&
+                 meta_functions::_Is_constructible_from_args<_Alternative<I>, Args...>
+    constexpr explicit Variant(std::allocator_arg_t, const allocator_type& allocator,
+        std::in_place_index_t<I>, Args&&... args)
+        : _storage(), _allocator(allocator) {
+        _create<I>(_storage, _allocator, std::forward<Args>(args)...);
+        _set_index(I);
+    }
+
+    template<size_t I, typename UType, typename... Args>
+        requires _allocator_aware && meta_functions::_Is_index_of_alternative<I, Types...>&&
+                 meta_functions::_Is_constructible_from_init_list<_Alternative<I>, UType, Args...>
+    constexpr explicit Variant(std::allocator_arg_t, const allocator_type& allocator,
+        std::in_place_index_t<I>, std::initializer_list<UType> il, Args&&... args)
+        : _storage(), _allocator(allocator) {
+        _create<I>(_storage, _allocator, il, std::forward<Args>(args)...);
+        _set_index(I);
+    }
+
+    constexpr allocator_type get_allocator() const noexcept
+        requires _allocator_aware
+    {
+        return _allocator;
+    }
+
+    constexpr ~Variant()
+        requires meta_functions::_All_trivially_destructible<Types...> = default;
+
+    constexpr ~Variant() {
+        _destroy_active();
+    }
+
 public:
     template<typename Type, typename... Args>
-        requires meta_functions::_Is_type_present<Type, Types...>&&
+        requires _is_alternative<Type>&&
                  meta_functions::_Is_constructible_from_args<Type, Args...>
     constexpr Type& emplace(Args&&... args) {
-        constexpr std::size_t new_index = meta_functions::_Get_index_v<Type, Types...>;
-        return _emplace_impl<Type>(new_index, [&] {
-            _storage.create<Type>(std::forward<Args>(args)...); });
+        return _replace<_index_of<Type>>(std::forward<Args>(args)...);
     }
 
     template<typename Type, typename UType, typename... Args>
-        requires meta_functions::_Is_type_present<Type, Types...>&&
+        requires _is_alternative<Type>&&
                  meta_functions::_Is_constructible_from_init_list<Type, UType, Args...>
     constexpr Type& emplace(std::initializer_list<UType> il, Args&&... args) {
-        constexpr std::size_t new_index = meta_functions::_Get_index_v<Type, Types...>;
-        return _emplace_impl<Type>(new_index, [&] {
-            _storage.create<Type>(il, std::forward<Args>(args)...); });
+        return _replace<_index_of<Type>>(il, std::forward<Args>(args)...);
     }
 
     template<std::size_t I, typename... Args>
         requires meta_functions::_Is_index_of_alternative<I, Types...>&&
-                 meta_functions::_Is_constructible_from_args<meta_functions::_Get_type_t<I, Types...>, Args...>
-    constexpr meta_functions::_Get_type_t<I, Types...>& emplace(Args&&... args) {
-        using Type = meta_functions::_Get_type_t<I, Types...>;
-        return _emplace_impl<Type>(I, [&] {
-            _storage.create<Type>(std::forward<Args>(args)...); });
+                 meta_functions::_Is_constructible_from_args<_Alternative<I>, Args...>
+    constexpr _Alternative<I>& emplace(Args&&... args) {
+        return _replace<I>(std::forward<Args>(args)...);
     }
 
     template<std::size_t I, typename UType, typename... Args>
         requires meta_functions::_Is_index_of_alternative<I, Types...>&&
-                 meta_functions::_Is_constructible_from_init_list<meta_functions::_Get_type_t<I, Types...>, UType, Args...>
-    constexpr meta_functions::_Get_type_t<I, Types...>& emplace(std::initializer_list<UType> il, Args&&... args) {
-        using Type = meta_functions::_Get_type_t<I, Types...>;
-        return _emplace_impl<Type>(I, [&] {
-            _storage.create<Type>(il, std::forward<Args>(args)...); });
+                 meta_functions::_Is_constructible_from_init_list<_Alternative<I>, UType, Args...>
+    constexpr _Alternative<I>& emplace(std::initializer_list<UType> il, Args&&... args) {
+        return _replace<I>(il, std::forward<Args>(args)...);
     }
 
 public:
@@ -226,22 +654,24 @@ public:
             return;
         }
 
-        if (_index == other._index) {
-            ((meta_functions::_Get_index_v<Types, Types...> == _index ?
-                std::swap(_storage.get<Types>(), other._storage.get<Types>())
-                : void()), ...);
+        if (_get_index() == other._get_index() && _same_allocator(other)) {
+            variant_detail::_Dispatch<sizeof...(Types), void>(_get_index(),
+                [](auto I, _Storage& lhs, _Storage& rhs) {
+                    using Type = _Stored<decltype(I)::value>;
+                    std::swap(lhs.template get<Type>(), rhs.template get<Type>());
+                }, _storage, other._storage);
             return;
         }
 
         if (valueless_by_exception()) {
             *this = std::move(other);
-            other._index = npos;
+            other._set_index(_valueless_index);
             return;
         }
 
         if (other.valueless_by_exception()) {
             other = std::move(*this);
-            _index = npos;
+            _set_index(_valueless_index);
             return;
         }
 
@@ -251,44 +681,44 @@ public:
     }
 
 public:
+    constexpr Variant& operator=(const Variant& other)
+        requires meta_functions::_All_copy_constructible<Types...>&&
+                 meta_functions::_All_copy_assignable<Types...>&&
+                 meta_functions::_All_trivially_copy_assignable<Types...> = default;
+
     constexpr Variant& operator=(const Variant& other)
         noexcept(((std::is_nothrow_copy_constructible_v<Types>&&
                 std::is_nothrow_copy_assignable_v<Types>) && ...))
         requires meta_functions::_All_copy_constructible<Types...>&&
                  meta_functions::_All_copy_assignable<Types...>
     {
-        if (*this == other) return *this;
-
-        if constexpr (((std::is_trivially_copy_constructible_v<Types> &&
-            std::is_trivially_copy_assignable_v<Types> &&
-            std::is_trivially_destructible_v<Types>) && ...)) {
-            _index = other._index;
-            _storage = other._storage;
-
+        if (this == std::addressof(other)) {
+            return *this;
         }
-        else {
-            if (other.valueless_by_exception()) {
-                ((meta_functions::_Get_index_v<Types, Types...> == _index ?
-                    _storage.destroy<Types>()
-                    : void()), ...);
-                _index = npos;
-                return *this;
-            }
 
-            constexpr bool isNoexcept = ((std::is_nothrow_copy_constructible_v<Types> &&
-                std::is_nothrow_copy_assignable_v<Types>) && ...);
+        if (other.valueless_by_exception()) {
+            _destroy_active();
+            _set_index(_valueless_index);
+            return *this;
+        }
 
-            bool isSameType = (((meta_functions::_Get_index_v<Types, Types...> == other._index ?
-                std::is_copy_assignable_v<Types> : 0) + ...) && _index == other._index);
+        [[maybe_unused]] constexpr bool isNoexcept = ((std::is_nothrow_copy_constructible_v<Types> &&
+            std::is_nothrow_copy_assignable_v<Types>) && ...);
 
-            ((meta_functions::_Get_index_v<Types, Types...> == other._index ?
-                variant_assign<isNoexcept, const Types&>(
-                    isSameType, other._index, other._storage.get<Types>())
-                : void()), ...);
-        }
+        variant_detail::_Dispatch<sizeof...(Types), void>(other._get_index(),
+            [](auto I, Variant& self, const Variant& source) {
+                using Type = _Stored<decltype(I)::value>;
+                self.template variant_assign<decltype(I)::value, isNoexcept>(
+                    source._storage.template get<Type>());
+            }, *this, other);
         return *this;
     }
 
+    constexpr Variant& operator=(Variant&& other)
+        requires meta_functions::_All_move_constructible<Types...>&&
+                 meta_functions::_All_move_assignable<Types...>&&
+                 meta_functions::_All_trivially_move_assignable<Types...> = default;
+
 
     constexpr Variant& operator=(Variant&& other)
         noexcept(((std::is_nothrow_move_constructible_v<Types>&&
@@ -296,64 +726,53 @@ public:
         requires meta_functions::_All_move_constructible<Types...>&&
                  meta_functions::_All_move_assignable<Types...>
     {
-        if (*this == other) return *this;
-
-        if constexpr (((std::is_trivially_move_constructible_v<Types> &&
-            std::is_trivially_move_assignable_v<Types> &&
-            std::is_trivially_destructible_v<Types>) && ...)) {
-            _index = other._index;
-            _storage = other._storage;
-
+        if (this == std::addressof(other)) {
+            return *this;
         }
-        else {
 
-            if (other.valueless_by_exception()) {
-                ((meta_functions::_Get_index_v<Types, Types...> == _index ?
-                    _storage.destroy<Types>()
-                    : void()), ...);
-                _index = npos;
-                return *this;
-            }
-
-            constexpr bool isNoexcept = ((std::is_nothrow_move_constructible_v<Types> &&
-                std::is_nothrow_move_assignable_v<Types>) && ...);
-
-            bool isSameType = (((meta_functions::_Get_index_v<Types, Types...> == other._index ?
-                std::is_move_assignable_v<Types> : 0) + ...) && _index == other._index);
+        if (other.valueless_by_exception()) {
+            _destroy_active();
+            _set_index(_valueless_index);
+            return *this;
+        }
 
-            ((meta_functions::_Get_index_v<Types, Types...> == other._index ?
-                variant_assign<isNoexcept, Types>(
-                    isSameType, other._index, std::move(other._storage.get<Types>()))
-                : void()), ...);
+        [[maybe_unused]] constexpr bool isNoexcept = ((std::is_nothrow_move_constructible_v<Types> &&
+            std::is_nothrow_move_assignable_v<Types>) && ...);
+
+        variant_detail::_Dispatch<sizeof...(Types), void>(other._get_index(),
+            [](auto I, Variant& self, Variant& source) {
+                using Type = _Stored<decltype(I)::value>;
+                self.template variant_assign<decltype(I)::value, isNoexcept>(
+                    std::move(source._storage.template get<Type>()));
+            }, *this, other);
+        if constexpr (!never_valueless) {
+            other._destroy_active();
+            other._set_index(_valueless_index);
         }
-        other._index = npos;
 
         return *this;
     }
 
     template<typename Type>
-        requires meta_functions::_Is_type_present<std::remove_cvref_t<Type>, Types...>&&
+        requires _is_alternative<std::remove_cvref_t<Type>>&&
                  meta_functions::_Is_constructible_from_itself<Type>&& meta_functions::_Is_assignable<Type>
     constexpr Variant& operator=(Type&& obj)
-        noexcept((std::is_nothrow_constructible_v<std::remove_cvref_t<Type>, Type&&>&&
-                std::is_nothrow_assignable_v<Type&, Type&&>)) {
-        using Pure_type = std::remove_cvref_t<Type>;
-
-        constexpr bool isNoexcept = (std::is_nothrow_constructible_v<Pure_type, Type> &&
-            std::is_nothrow_assignable_v<Pure_type, Type>);
+        noexcept((_is_nothrow_creatable<_index_of<std::remove_cvref_t<Type>>, Type&&>&&
+                std::is_nothrow_assignable_v<_Stored<_index_of<std::remove_cvref_t<Type>>>&, Type&&>)) {
+        constexpr size_t obj_index = _index_of<std::remove_cvref_t<Type>>;
 
-        constexpr size_t obj_index = meta_functions::_Get_index_v<Pure_type, Types...>;
-        bool isSameType = (_index == obj_index) && std::is_assignable_v<Pure_type, Type>;
+        constexpr bool isNoexcept = (_is_nothrow_creatable<obj_index, Type> &&
+            std::is_nothrow_assignable_v<_Stored<obj_index>&, Type>);
 
-        variant_assign<isNoexcept, Type>(isSameType, obj_index, std::forward<Type>(obj));
+        variant_assign<obj_index, isNoexcept>(std::forward<Type>(obj));
 
         return *this;
     }
 
 
     constexpr bool operator==(const Variant& other) const
-        noexcept((meta_functions::is_nothrow_equality_comparable_v<Types> && ...))
-        requires meta_functions::_All_equality_comparable<Types...>
+        noexcept((meta_functions::is_nothrow_equality_comparable_v<variant_detail::_Unboxed_t<Types>> && ...))
+        requires meta_functions::_All_equality_comparable<variant_detail::_Unboxed_t<Types>...>
     {
 
         if (valueless_by_exception() && other.valueless_by_exception()) {
@@ -364,13 +783,14 @@ public:
             return false;
         }
 
-        if (_index != other._index) {
+        if (_get_index() != other._get_index()) {
             return false;
         }
 
-        return (((meta_functions::_Get_index_v<Types, Types...> == _index) ?
-            (_storage.get<Types>() == other._storage.get<Types>())
-            : false) || ...);
+        return variant_detail::_Dispatch<sizeof...(Types), bool>(_get_index(),
+            [](auto I, const _Storage& lhs, const _Storage& rhs) -> bool {
+                return _get<decltype(I)::value>(lhs) == _get<decltype(I)::value>(rhs);
+            }, _storage, other._storage);
     }
 
     constexpr bool operator!=(const Variant& other) {
@@ -378,96 +798,231 @@ public:
     }
 
 public:
-    template <typename Type>
-        requires meta_functions::_Is_type_present<Type, Types...>
+    template <typename Type, VariantAccessPolicy Policy = VariantAccessPolicy::checked>
+        requires _is_alternative<Type>
     constexpr const Type& get() const& {
-        validate_access<meta_functions::_Get_index_v<Type, Types...>>();
-        return _storage.get<Type>();
+        validate_access<_index_of<Type>, Policy>();
+        return _get<_index_of<Type>>(_storage);
     }
 
-    template <typename Type>
-        requires meta_functions::_Is_type_present<Type, Types...>
+    template <typename Type, VariantAccessPolicy Policy = VariantAccessPolicy::checked>
+        requires _is_alternative<Type>
     constexpr Type& get()& {
-        validate_access<meta_functions::_Get_index_v<Type, Types...>>();
-        return _storage.get<Type>();
+        validate_access<_index_of<Type>, Policy>();
+        return _get<_index_of<Type>>(_storage);
     }
 
-    template <typename Type>
-        requires meta_functions::_Is_type_present<Type, Types...>
+    template <typename Type, VariantAccessPolicy Policy = VariantAccessPolicy::checked>
+        requires _is_alternative<Type>
     constexpr const Type&& get() const&& {
-        validate_access<meta_functions::_Get_index_v<Type, Types...>>();
-        return std::move(_storage.get<Type>());
+        validate_access<_index_of<Type>, Policy>();
+        return std::move(_get<_index_of<Type>>(_storage));
     }
 
-    template <typename Type>
-        requires meta_functions::_Is_type_present<Type, Types...>
+    template <typename Type, VariantAccessPolicy Policy = VariantAccessPolicy::checked>
+        requires _is_alternative<Type>
     constexpr Type&& get()&& {
-        validate_access<meta_functions::_Get_index_v<Type, Types...>>();
-        return std::move(_storage.get<Type>());
+        validate_access<_index_of<Type>, Policy>();
+        return std::move(_get<_index_of<Type>>(_storage));
     }
 
-    template <size_t I>
+    template <size_t I, VariantAccessPolicy Policy = VariantAccessPolicy::checked>
         requires meta_functions::_Is_index_of_alternative<I, Types...>
-    constexpr const meta_functions::_Get_type_t<I, Types...>& get() const& {
-        validate_access<I>();
-        return _storage.get<meta_functions::_Get_type_t<I, Types...>>();
+    constexpr const _Alternative<I>& get() const& {
+        validate_access<I, Policy>();
+        return _get<I>(_storage);
     }
 
-    template <size_t I>
+    template <size_t I, VariantAccessPolicy Policy = VariantAccessPolicy::checked>
         requires meta_functions::_Is_index_of_alternative<I, Types...>
-    constexpr meta_functions::_Get_type_t<I, Types...>& get()& {
-        validate_access<I>();
-        return _storage.get<meta_functions::_Get_type_t<I, Types...>>();
+    constexpr _Alternative<I>& get()& {
+        validate_access<I, Policy>();
+        return _get<I>(_storage);
     }
 
-    template <size_t I>
+    template <size_t I, VariantAccessPolicy Policy = VariantAccessPolicy::checked>
         requires meta_functions::_Is_index_of_alternative<I, Types...>
-    constexpr const meta_functions::_Get_type_t<I, Types...>&& get() const&& {
-        validate_access<I>();
-        return std::move(_storage.get<meta_functions::_Get_type_t<I, Types...>>());
+    constexpr const _Alternative<I>&& get() const&& {
+        validate_access<I, Policy>();
+        return std::move(_get<I>(_storage));
     }
 
-    template <size_t I>
+    template <size_t I, VariantAccessPolicy Policy = VariantAccessPolicy::checked>
         requires meta_functions::_Is_index_of_alternative<I, Types...>
-    constexpr meta_functions::_Get_type_t<I, Types...>&& get()&& {
-        validate_access<I>();
-        return std::move(_storage.get<meta_functions::_Get_type_t<I, Types...>>());
+    constexpr _Alternative<I>&& get()&& {
+        validate_access<I, Policy>();
+        return std::move(_get<I>(_storage));
     }
 
 public:
     template <typename Type>
-        requires meta_functions::_Is_type_present<Type, Types...>
+        requires _is_alternative<Type>
     constexpr Type* get_if() & noexcept {
         return (!valueless_by_exception() &&
-            _index == meta_functions::_Get_index_v<Type, Types...>)
-            ? &_storage.get<Type>()
+            _get_index() == _index_of<Type>)
+            ? &_get<_index_of<Type>>(_storage)
             : nullptr;
     }
 
     template <typename Type>
-        requires meta_functions::_Is_type_present<Type, Types...>
+        requires _is_alternative<Type>
     constexpr const Type* get_if() const& noexcept {
         return (!valueless_by_exception() &&
-            _index == meta_functions::_Get_index_v<Type, Types...>)
-            ? &_storage.get<Type>()
+            _get_index() == _index_of<Type>)
+            ? &_get<_index_of<Type>>(_storage)
             : nullptr;
     }
 
     template <std::size_t I>
         requires meta_functions::_Is_index_of_alternative<I, Types...>
-    constexpr meta_functions::_Get_type_t<I, Types...>* get_if() & noexcept {
+    constexpr _Alternative<I>* get_if() & noexcept {
         return (!valueless_by_exception() &&
-            _index == I)
-            ? &_storage.get<meta_functions::_Get_type_t<I, Types...>>()
+            _get_index() == I)
+            ? &_get<I>(_storage)
             : nullptr;
     }
 
     template <std::size_t I>
         requires meta_functions::_Is_index_of_alternative<I, Types...>
-    constexpr const meta_functions::_Get_type_t<I, Types...>* get_if() const& noexcept {
+    constexpr const _Alternative<I>* get_if() const& noexcept {
         return (!valueless_by_exception() &&
-            _index == I)
-            ? &_storage.get<meta_functions::_Get_type_t<I, Types...>>()
+            _get_index() == I)
+            ? &_get<I>(_storage)
             : nullptr;
     }
+
+public:
+    template <typename Type>
+        requires _is_alternative<Type>
+    constexpr VariantAccessResult<Type> try_get() & noexcept {
+        return try_get<_index_of<Type>>();
+    }
+
+    template <typename Type>
+        requires _is_alternative<Type>
+    constexpr VariantAccessResult<const Type> try_get() const& noexcept {
+        return try_get<_index_of<Type>>();
+    }
+
+    template <std::size_t I>
+        requires meta_functions::_Is_index_of_alternative<I, Types...>
+    constexpr VariantAccessResult<_Alternative<I>> try_get() & noexcept {
+        if (_get_index() != I) {
+            return _access_error();
+        }
+        return _get<I>(_storage);
+    }
+
+    template <std::size_t I>
+        requires meta_functions::_Is_index_of_alternative<I, Types...>
+    constexpr VariantAccessResult<const _Alternative<I>> try_get() const& noexcept {
+        if (_get_index() != I) {
+            return _access_error();
+        }
+        return _get<I>(_storage);
+    }
+
+public:
+    template<typename Visitor>
+    constexpr decltype(auto) visit(Visitor&& visitor)& {
+        return _visit_impl(*this, std::forward<Visitor>(visitor));
+    }
+
+    template<typename Visitor>
+    constexpr decltype(auto) visit(Visitor&& visitor) const& {
+        return _visit_impl(*this, std::forward<Visitor>(visitor));
+    }
+
+    template<typename Visitor>
+    constexpr decltype(auto) visit(Visitor&& visitor)&& {
+        return _visit_impl(std::move(*this), std::forward<Visitor>(visitor));
+    }
+
+    template<typename Visitor>
+    constexpr decltype(auto) visit(Visitor&& visitor) const&& {
+        return _visit_impl(std::move(*this), std::forward<Visitor>(visitor));
+    }
 };
+
+namespace meta_functions {
+    template<typename Type>
+    struct _Is_variant_impl : std::false_type {};
+
+    template<typename... Types>
+    struct _Is_variant_impl<Variant<Types...>> : std::true_type {};
+
+    template<typename Type>
+    concept _Is_variant = _Is_variant_impl<std::remove_cvref_t<Type>>::value;
+
+    // The index is a plain integer or a niche in the storage bytes, and the
+    // storage holds at most one alternative in place, so copying the bytes
+    // relocates the whole Variant.
+    template<typename... Types>
+    struct is_trivially_relocatable<Variant<Types...>>
+        : std::bool_constant<(is_trivially_relocatable_v<Types> && ...)> {};
+
+    // Index values and storage niches that no state of the Variant uses, for
+    // wrappers such as Optional to mark their own states with. They are
+    // exported for every pack; an enclosing Variant uses them only when its
+    // own pack opts in with enable_compact_layout.
+    template<typename... Types>
+    struct niche_traits<Variant<Types...>>
+        : std::conditional_t<Variant<Types...>::_layout_kind == VariantLayoutKind::niche,
+            niche_traits<typename Variant<Types...>::_Storage>,
+            variant_detail::_Index_niche_traits<typename Variant<Types...>::_Index_type,
+                Variant<Types...>::_index_offset, sizeof...(Types)>> {};
+}
+
+namespace variant_detail {
+    struct _Variant_access {
+        template<std::size_t I, typename VariantType>
+        static constexpr auto&& _Get_alternative(VariantType&& variant) noexcept {
+            return _Forward_like<VariantType>(
+                std::remove_cvref_t<VariantType>::template _get<I>(variant._storage));
+        }
+
+        template<typename VariantType>
+        static constexpr VariantLayout _Layout() noexcept {
+            return { VariantType::_layout_kind, sizeof(VariantType), alignof(VariantType),
+                VariantType::_index_offset, VariantType::_index_size };
+        }
+    };
+}
+
+// Layout of a Variant instantiation: which index placement it uses, its size
+// and alignment, and the bytes holding the index.
+template<typename VariantType>
+    requires meta_functions::_Is_variant<VariantType>
+inline constexpr VariantLayout variant_layout_v =
+    variant_detail::_Variant_access::_Layout<std::remove_cvref_t<VariantType>>();
+
+template<typename Visitor, typename VariantType>
+    requires meta_functions::_Is_variant<VariantType>
+constexpr decltype(auto) visit(Visitor&& visitor, VariantType&& variant) {
+    return std::forward<VariantType>(variant).visit(std::forward<Visitor>(visitor));
+}
+
+template<typename Visitor, typename... VariantTypes>
+    requires (sizeof...(VariantTypes) > 1) && (meta_functions::_Is_variant<VariantTypes> && ...)
+constexpr decltype(auto) visit(Visitor&& visitor, VariantTypes&&... variants) {
+    using Result = std::invoke_result_t<Visitor,
+        decltype(variant_detail::_Variant_access::_Get_alternative<0>(
+            std::declval<VariantTypes>()))...>;
+
+    if ((variants.valueless_by_exception() || ...)) {
+        variant_detail::_Throw_bad_access(VariantAccessError::valueless);
+    }
+
+    return variant_detail::_Multi_dispatch<Result,
+        std::remove_cvref_t<VariantTypes>::alternatives_count...>({ variants.index()... },
+        []<std::size_t... Is, typename... Sources>(std::index_sequence<Is...>,
+            Visitor&& target, Sources&&... sources) -> Result {
+            static_assert(std::is_same_v<Result, std::invoke_result_t<Visitor,
+                decltype(variant_detail::_Variant_access::_Get_alternative<Is>(
+                    std::declval<Sources>()))...>>,
+                "Visitor must return the same type for all combinations of alternatives");
+            return std::invoke(std::forward<Visitor>(target),
+                variant_detail::_Variant_access::_Get_alternative<Is>(
+                    std::forward<Sources>(sources))...);
+        }, std::forward<Visitor>(visitor), std::forward<VariantTypes>(variants)...);
+}
@@ -0,0 +1,394 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../detail/TagScan.hpp"
+#include "Variant.hpp"
+#include "VariantArray.hpp"
+#include "VariantCollection.hpp"
+
+
+// Algorithms that select elements by alternative, for a VariantArray and for
+// any input range of Variants. On a VariantArray with one-byte tags they scan
+// the tag column with the SIMD kernels of TagScan.hpp. A range of Variants
+// is read element by element through index(): its index bytes are spread
+// across the elements, so the scan costs a pass over the whole range anyway.
+namespace variant_detail {
+    template<typename Type, typename Container>
+    struct _Alternative_index;
+
+    template<typename Type, typename... Types>
+        requires meta_functions::_Is_type_present<Type, _Unboxed_t<Types>...>
+    struct _Alternative_index<Type, Variant<Types...>>
+        : _Index_constant<meta_functions::_Get_index_v<Type, _Unboxed_t<Types>...>> {};
+
+    template<typename Type, typename... Types>
+        requires meta_functions::_Is_type_present<Type, Types...>
+    struct _Alternative_index<Type, VariantArray<Types...>>
+        : _Index_constant<meta_functions::_Get_index_v<Type, Types...>> {};
+
+    template<typename Type>
+    inline constexpr bool _Is_variant_array_v = false;
+
+    template<typename... Types>
+    inline constexpr bool _Is_variant_array_v<VariantArray<Types...>> = true;
+
+    template<typename Type, typename Container>
+    inline constexpr std::size_t _Alternative_index_v = _Alternative_index<Type, std::remove_cvref_t<Container>>::value;
+
+    template<typename Type, typename Container>
+    concept _Has_alternative = requires { _Alternative_index<Type, std::remove_cvref_t<Container>>::value; };
+
+    template<typename Range>
+    concept _Variant_range = std::ranges::input_range<Range> &&
+        meta_functions::_Is_variant<std::ranges::range_value_t<Range>>;
+
+    template<typename Range>
+    using _Range_variant_t = std::remove_cvref_t<std::ranges::range_value_t<Range>>;
+
+    // Position of the first element at or after from that holds the
+    // alternative with index tag, or array.size().
+    template<typename Array>
+    std::size_t _Find_in_array(const Array& array, std::size_t from, std::size_t tag) noexcept {
+        const auto tags = array.tags();
+        if constexpr (sizeof(typename Array::tag_type) == 1) {
+            return _Find_tag(tags.data(), tags.size(), from, static_cast<std::uint8_t>(tag));
+        }
+        else {
+            while (from < tags.size() && tags[from] != tag) {
+                ++from;
+            }
+            return from;
+        }
+    }
+
+    // The elements of a VariantArray that hold Type, found by scanning the
+    // tag column.
+    template<typename Array, typename Type>
+    class _Alternative_array_view : public std::ranges::view_interface<_Alternative_array_view<Array, Type>> {
+    private:
+        inline static constexpr std::size_t _tag = _Alternative_index_v<Type, Array>;
+
+        Array* _array = nullptr;
+
+    public:
+        class iterator {
+        private:
+            Array* _array = nullptr;
+            std::size_t _position = 0;
+
+        public:
+            using value_type = Type;
+            using difference_type = std::ptrdiff_t;
+            using iterator_concept = std::forward_iterator_tag;
+
+            iterator() = default;
+
+            iterator(Array& array, std::size_t from) noexcept
+                : _array(&array), _position(_Find_in_array(array, from, _tag)) {}
+
+            decltype(auto) operator*() const noexcept {
+                return (*_array)[_position].template get<Type, VariantAccessPolicy::unchecked>();
+            }
+
+            iterator& operator++() noexcept {
+                _position = _Find_in_array(*_array, _position + 1, _tag);
+                return *this;
+            }
+
+            iterator operator++(int) noexcept {
+                iterator copy = *this;
+                ++*this;
+                return copy;
+            }
+
+            // Where the element is in the array.
+            std::size_t position() const noexcept {
+                return _position;
+            }
+
+            bool operator==(const iterator& other) const noexcept {
+                return _position == other._position;
+            }
+
+            bool operator==(std::default_sentinel_t) const noexcept {
+                return _position == _array->size();
+            }
+        };
+
+        _Alternative_array_view() = default;
+
+        explicit _Alternative_array_view(Array& array) noexcept : _array(&array) {}
+
+        iterator begin() const noexcept {
+            return iterator(*_array, 0);
+        }
+
+        std::default_sentinel_t end() const noexcept {
+            return std::default_sentinel;
+        }
+    };
+
+    template<typename Type>
+    struct _Alternative_adaptor {
+        template<typename Array>
+            requires std::is_lvalue_reference_v<Array> && _Has_alternative<Type, Array> &&
+                     (!meta_functions::_Is_variant<Array>)
+        auto operator()(Array&& array) const noexcept {
+            return _Alternative_array_view<std::remove_reference_t<Array>, Type>(array);
+        }
+
+        template<std::ranges::viewable_range Range>
+            requires _Variant_range<Range> && _Has_alternative<Type, _Range_variant_t<Range>>
+        auto operator()(Range&& range) const {
+            return std::views::filter(std::forward<Range>(range), [](const auto& variant) {
+                return variant.template holds_alternative<Type>();
+            }) | std::views::transform([](auto&& variant) -> decltype(auto) {
+                return variant.template get<Type, VariantAccessPolicy::unchecked>();
+            });
+        }
+
+        template<typename Range>
+            requires std::is_invocable_v<const _Alternative_adaptor&, Range>
+        friend auto operator|(Range&& range, const _Alternative_adaptor& adaptor) {
+            return adaptor(std::forward<Range>(range));
+        }
+    };
+}
+
+namespace variant_views {
+    // range | variant_views::alternative<Type> yields a reference to the Type
+    // of every element that holds it, in order.
+    template<typename Type>
+    inline constexpr variant_detail::_Alternative_adaptor<Type> alternative{};
+}
+
+template<typename Type, typename... Types>
+    requires meta_functions::_Is_type_present<Type, Types...>
+std::size_t count_alternative(const VariantArray<Types...>& array) noexcept {
+    return array.template count<Type>();
+}
+
+template<typename Type, typename Range>
+    requires variant_detail::_Variant_range<Range> &&
+             variant_detail::_Has_alternative<Type, variant_detail::_Range_variant_t<Range>>
+std::size_t count_alternative(Range&& range) {
+    constexpr std::size_t index = variant_detail::_Alternative_index_v<Type, variant_detail::_Range_variant_t<Range>>;
+    std::size_t total = 0;
+    for (const auto& variant : range) {
+        total += variant.index() == index;
+    }
+    return total;
+}
+
+// The number of elements holding each alternative. Valueless elements are
+// not counted.
+template<typename... Types>
+std::array<std::size_t, sizeof...(Types)> index_histogram(const VariantArray<Types...>& array) noexcept {
+    return array.histogram();
+}
+
+template<typename Range>
+    requires variant_detail::_Variant_range<Range>
+auto index_histogram(Range&& range) {
+    using VariantType = variant_detail::_Range_variant_t<Range>;
+    std::array<std::size_t, VariantType::alternatives_count> counts{};
+    for (const auto& variant : range) {
+        if (!variant.valueless_by_exception()) {
+            ++counts[variant.index()];
+        }
+    }
+    return counts;
+}
+
+// The positions of the elements grouped by alternative: result[I] lists, in
+// order, where the elements holding the I-th alternative are. Valueless
+// elements are in no list.
+template<typename... Types>
+std::array<std::vector<std::size_t>, sizeof...(Types)> partition_by_index(const VariantArray<Types...>& array) {
+    std::array<std::vector<std::size_t>, sizeof...(Types)> positions;
+    const auto tags = array.tags();
+    if constexpr (sizeof(typename VariantArray<Types...>::tag_type) == 1) {
+        // Sized up front from the histogram, so positions are written
+        // through plain pointers.
+        const auto counts = array.histogram();
+        std::array<std::size_t*, sizeof...(Types)> cursors;
+        for (std::size_t index = 0; index < sizeof...(Types); ++index) {
+            positions[index].resize(counts[index]);
+            cursors[index] = positions[index].data();
+        }
+        variant_detail::_Tag_positions(tags.data(), tags.size(), cursors.data());
+    }
+    else {
+        for (std::size_t position = 0; position < tags.size(); ++position) {
+            positions[tags[position]].push_back(position);
+        }
+    }
+    return positions;
+}
+
+template<typename Range>
+    requires variant_detail::_Variant_range<Range>
+auto partition_by_index(Range&& range) {
+    using VariantType = variant_detail::_Range_variant_t<Range>;
+    std::array<std::vector<std::size_t>, VariantType::alternatives_count> positions;
+    std::size_t position = 0;
+    for (const auto& variant : range) {
+        if (!variant.valueless_by_exception()) {
+            positions[variant.index()].push_back(position);
+        }
+        ++position;
+    }
+    return positions;
+}
+
+// How visit_batch calls the visitor: with each element, or once per
+// alternative with a std::span of all elements holding it. Spans need the
+// elements of an alternative to be contiguous, as in a VariantCollection.
+enum class VariantBatchMode : unsigned char {
+    elements,
+    spans
+};
+
+namespace variant_detail {
+    // Positions of a range's elements sorted by alternative, with a counting
+    // pass and a placement pass: the elements holding the I-th alternative
+    // are at order[starts[I]] up to order[starts[I + 1]], in range order.
+    template<std::size_t N>
+    struct _Buckets {
+        std::array<std::size_t, N + 1> starts{};
+        std::vector<std::size_t> order;
+
+        explicit _Buckets(const std::array<std::size_t, N>& counts) {
+            for (std::size_t index = 0; index < N; ++index) {
+                starts[index + 1] = starts[index] + counts[index];
+            }
+            order.resize(starts[N]);
+        }
+
+        std::array<std::size_t*, N> cursors() noexcept {
+            std::array<std::size_t*, N> result;
+            for (std::size_t index = 0; index < N; ++index) {
+                result[index] = order.data() + starts[index];
+            }
+            return result;
+        }
+
+        std::span<const std::size_t> bucket(std::size_t index) const noexcept {
+            return std::span<const std::size_t>(order).subspan(starts[index], starts[index + 1] - starts[index]);
+        }
+    };
+
+    template<typename... Types>
+    _Buckets<sizeof...(Types)> _Bucket_by_index(const VariantArray<Types...>& array) {
+        _Buckets<sizeof...(Types)> buckets(array.histogram());
+        const auto tags = array.tags();
+        auto cursors = buckets.cursors();
+        if constexpr (sizeof(typename VariantArray<Types...>::tag_type) == 1) {
+            _Tag_positions(tags.data(), tags.size(), cursors.data());
+        }
+        else {
+            for (std::size_t position = 0; position < tags.size(); ++position) {
+                *cursors[tags[position]]++ = position;
+            }
+        }
+        return buckets;
+    }
+
+    // Fails like visit on a valueless element, before any is visited.
+    template<typename Range>
+        requires _Variant_range<Range>
+    auto _Bucket_by_index(Range& range) {
+        constexpr std::size_t N = _Range_variant_t<Range>::alternatives_count;
+        std::array<std::size_t, N> counts{};
+        for (const auto& variant : range) {
+            if (variant.valueless_by_exception()) {
+                _Throw_bad_access(VariantAccessError::valueless);
+            }
+            ++counts[variant.index()];
+        }
+
+        _Buckets<N> buckets(counts);
+        auto cursors = buckets.cursors();
+        std::size_t position = 0;
+        for (const auto& variant : range) {
+            *cursors[variant.index()]++ = position++;
+        }
+        return buckets;
+    }
+
+    // Calls visitor with element(I, position) for every position in the
+    // I-th bucket, one alternative after another.
+    template<std::size_t... Is, typename Element, typename Visitor>
+    void _Visit_buckets(std::index_sequence<Is...>, const _Buckets<sizeof...(Is)>& buckets,
+        Element& element, Visitor& visitor) {
+        ([&] {
+            for (const std::size_t position : buckets.bucket(Is)) {
+                std::invoke(visitor, element(_Index_constant<Is>{}, position));
+            }
+        }(), ...);
+    }
+
+    template<VariantBatchMode Mode, typename Type, typename Visitor>
+    void _Visit_segment(std::span<Type> segment, Visitor& visitor) {
+        if constexpr (Mode == VariantBatchMode::spans) {
+            std::invoke(visitor, segment);
+        }
+        else {
+            for (Type& element : segment) {
+                std::invoke(visitor, element);
+            }
+        }
+    }
+}
+
+// Visits every element of a random access range of Variants grouped by
+// alternative: one pass counts the indices and one sorts the positions, then
+// the visitor runs over the elements of each alternative in turn, in a loop
+// that calls it with a single type. Alternatives are visited in index
+// order, and the elements of each in range order. Fails like visit,
+// before calling the visitor, if an element is valueless.
+template<VariantBatchMode Mode = VariantBatchMode::elements, typename Range, typename Visitor>
+    requires (Mode == VariantBatchMode::elements) && variant_detail::_Variant_range<Range> &&
+             std::ranges::random_access_range<Range>
+void visit_batch(Range&& range, Visitor&& visitor) {
+    constexpr std::size_t N = variant_detail::_Range_variant_t<Range>::alternatives_count;
+    const auto buckets = variant_detail::_Bucket_by_index(range);
+    const auto first = std::ranges::begin(range);
+    auto element = [&first](auto I, std::size_t position) -> decltype(auto) {
+        return first[static_cast<std::ranges::range_difference_t<Range>>(position)]
+            .template get<decltype(I)::value, VariantAccessPolicy::unchecked>();
+    };
+    variant_detail::_Visit_buckets(std::make_index_sequence<N>{}, buckets, element, visitor);
+}
+
+template<VariantBatchMode Mode = VariantBatchMode::elements, typename Array, typename Visitor>
+    requires (Mode == VariantBatchMode::elements) &&
+             variant_detail::_Is_variant_array_v<std::remove_cvref_t<Array>>
+void visit_batch(Array& array, Visitor&& visitor) {
+    constexpr std::size_t N = std::remove_cvref_t<Array>::alternatives_count;
+    const auto buckets = variant_detail::_Bucket_by_index(array);
+    auto element = [&array](auto I, std::size_t position) -> decltype(auto) {
+        return array[position].template get<decltype(I)::value, VariantAccessPolicy::unchecked>();
+    };
+    variant_detail::_Visit_buckets(std::make_index_sequence<N>{}, buckets, element, visitor);
+}
+
+// A VariantCollection is grouped already: each segment is visited in turn,
+// element by element or, with VariantBatchMode::spans, as a whole.
+template<VariantBatchMode Mode = VariantBatchMode::elements, typename Visitor, typename... Types>
+void visit_batch(VariantCollection<Types...>& collection, Visitor&& visitor) {
+    (variant_detail::_Visit_segment<Mode>(collection.template segment<Types>(), visitor), ...);
+}
+
+template<VariantBatchMode Mode = VariantBatchMode::elements, typename Visitor, typename... Types>
+void visit_batch(const VariantCollection<Types...>& collection, Visitor&& visitor) {
+    (variant_detail::_Visit_segment<Mode>(collection.template segment<Types>(), visitor), ...);
+}
@@ -0,0 +1,586 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../detail/TagScan.hpp"
+#include "Variant.hpp"
+
+
+// A dense array of Variant<Types...> values kept as two columns: the index of
+// each element in a vector of compact tags, and the alternatives in a
+// parallel array of VariadicUnion<Types...>. Operations on the tags alone
+// (count, histogram, tags) never touch the payloads, and for_each_of reads
+// only the payloads of the elements that hold its alternative. One-byte tags,
+// as for any pack of up to 255 alternatives, are scanned 16 or 32 at a time
+// (see TagScan.hpp).
+// Elements are accessed through proxies with the surface of Variant. The
+// array is never valueless, which is why every alternative must be nothrow
+// move constructible: a replacement is built first and then moved in.
+// Growing invalidates every proxy and reference, as with std::vector.
+template<typename... Types>
+    requires meta_functions::_Is_pack_of_different_type<Types...>&&
+             meta_functions::_Is_pack_not_empty<Types...>&&
+             ((std::is_object_v<Types> && !std::is_array_v<Types> && !std::is_const_v<Types> &&
+               std::is_nothrow_move_constructible_v<Types>) && ...)
+class VariantArray final {
+private:
+    using _Payload = VariadicUnion<Types...>;
+
+    template<size_t I>
+    using _Alternative = meta_functions::_Get_type_t<I, Types...>;
+
+    template<typename Type>
+    inline static constexpr std::size_t _index_of = meta_functions::_Get_index_v<Type, Types...>;
+
+    template<typename Type>
+    inline static constexpr bool _is_alternative = meta_functions::_Is_type_present<Type, Types...>;
+
+    inline static constexpr bool _trivially_destructible = (std::is_trivially_destructible_v<Types> && ...);
+
+    inline static constexpr bool _trivially_relocatable =
+        (meta_functions::is_trivially_relocatable_v<Types> && ...);
+
+    inline static constexpr bool _byte_tags = sizeof...(Types) <= UINT8_MAX;
+
+    // Which alternatives the destructor has to visit.
+    inline static constexpr std::array<bool, sizeof...(Types)> _needs_destroy = {
+        !std::is_trivially_destructible_v<Types>...
+    };
+
+public:
+    using tag_type = meta_functions::_Index_type_t<sizeof...(Types)>;
+
+private:
+    std::vector<tag_type> _tags;
+    _Payload* _payloads = nullptr;
+    std::size_t _capacity = 0;
+
+    // Frees a new buffer if building into it throws.
+    struct _Buffer_guard {
+        _Payload* buffer;
+        std::size_t capacity;
+
+        ~_Buffer_guard() {
+            if (buffer != nullptr) {
+                std::allocator<_Payload>().deallocate(buffer, capacity);
+            }
+        }
+    };
+
+    void _relocate(_Payload* target) noexcept {
+        if constexpr (_trivially_relocatable) {
+            if (size() != 0) {
+                std::memcpy(static_cast<void*>(target), static_cast<const void*>(_payloads),
+                    size() * sizeof(_Payload));
+            }
+        }
+        else {
+            for (std::size_t position = 0; position < size(); ++position) {
+                std::construct_at(target + position);
+                variant_detail::_Dispatch<sizeof...(Types), void>(_tags[position],
+                    [](auto I, _Payload& source, _Payload& destination) {
+                        using Type = _Alternative<decltype(I)::value>;
+                        destination.template create<Type>(std::move(source.template get<Type>()));
+                        source.template destroy<Type>();
+                    }, _payloads[position], target[position]);
+            }
+        }
+    }
+
+    // Moves the elements to a new buffer of capacity. extra, if it builds
+    // an element after them, runs first, so that its arguments may still
+    // refer to elements of this array.
+    template<typename Extra>
+    void _reallocate(std::size_t capacity, Extra&& extra) {
+        _tags.reserve(capacity);
+        _Buffer_guard guard{ std::allocator<_Payload>().allocate(capacity), capacity };
+        std::forward<Extra>(extra)(guard.buffer + size());
+        _relocate(guard.buffer);
+        if (_payloads != nullptr) {
+            std::allocator<_Payload>().deallocate(_payloads, _capacity);
+        }
+        _payloads = std::exchange(guard.buffer, nullptr);
+        _capacity = capacity;
+    }
+
+    std::size_t _grown_capacity(std::size_t required) const noexcept {
+        return std::max({ required, 2 * _capacity, std::size_t(8) });
+    }
+
+    template<size_t I, typename... Args>
+    static void _create(_Payload* payload, Args&&... args) {
+        std::construct_at(payload);
+        payload->template create<_Alternative<I>>(std::forward<Args>(args)...);
+    }
+
+    template<size_t I, typename... Args>
+    _Alternative<I>& _emplace_back(Args&&... args) {
+        if (size() == _capacity) {
+            _reallocate(_grown_capacity(size() + 1), [&args...](_Payload* payload) {
+                _create<I>(payload, std::forward<Args>(args)...);
+            });
+        }
+        else {
+            _create<I>(_payloads + size(), std::forward<Args>(args)...);
+        }
+        _tags.push_back(static_cast<tag_type>(I));
+        return _payloads[size() - 1].template get<_Alternative<I>>();
+    }
+
+    void _destroy(std::size_t position) noexcept {
+        if constexpr (!_trivially_destructible) {
+            if (_needs_destroy[_tags[position]]) {
+                variant_detail::_Dispatch<sizeof...(Types), void>(_tags[position],
+                    [](auto I, _Payload& payload) {
+                        payload.template destroy<_Alternative<decltype(I)::value>>();
+                    }, _payloads[position]);
+            }
+        }
+    }
+
+    void _destroy_all() noexcept {
+        if constexpr (!_trivially_destructible) {
+            for (std::size_t position = 0; position < size(); ++position) {
+                _destroy(position);
+            }
+        }
+    }
+
+    // Replaces the element at position with the I-th alternative.
+    template<size_t I, typename... Args>
+    _Alternative<I>& _replace(std::size_t position, Args&&... args) {
+        using Type = _Alternative<I>;
+        if constexpr (std::is_nothrow_constructible_v<Type, Args...>) {
+            _destroy(position);
+            _payloads[position].template create<Type>(std::forward<Args>(args)...);
+        }
+        else {
+            Type temp(std::forward<Args>(args)...);
+            _destroy(position);
+            _payloads[position].template create<Type>(std::move(temp));
+        }
+        _tags[position] = static_cast<tag_type>(I);
+        return _payloads[position].template get<Type>();
+    }
+
+    template<bool Const>
+    class _Element {
+    private:
+        using _Array = std::conditional_t<Const, const VariantArray, VariantArray>;
+
+        template<typename Type>
+        using _Ref = std::conditional_t<Const, const Type&, Type&>;
+
+        _Array* _array;
+        std::size_t _position;
+
+        template<size_t I, VariantAccessPolicy Policy>
+        void validate_access() const {
+            if constexpr (Policy == VariantAccessPolicy::checked) {
+                if (index() != I) {
+                    variant_detail::_Throw_bad_access(VariantAccessError::wrong_alternative);
+                }
+            }
+            else if constexpr (Policy == VariantAccessPolicy::asserting) {
+                assert(index() == I && "VariantArray: requested alternative is not active");
+            }
+            else {
+                variant_detail::_Assume(index() == I);
+            }
+        }
+
+        friend class VariantArray;
+
+        template<bool>
+        friend class _Element;
+
+        _Element(_Array& array, std::size_t position) noexcept
+            : _array(&array), _position(position) {}
+
+    public:
+        _Element(const _Element&) = default;
+
+        // Assigning through a proxy changes the element, never the proxy.
+        _Element& operator=(const _Element&) = delete;
+
+        operator _Element<true>() const noexcept
+            requires (!Const)
+        {
+            return _Element<true>(*_array, _position);
+        }
+
+        std::size_t index() const noexcept {
+            return _array->_tags[_position];
+        }
+
+        template<typename Type>
+            requires _is_alternative<Type>
+        bool holds_alternative() const noexcept {
+            return index() == _index_of<Type>;
+        }
+
+        template<size_t I, VariantAccessPolicy Policy = VariantAccessPolicy::checked>
+            requires meta_functions::_Is_index_of_alternative<I, Types...>
+        _Ref<_Alternative<I>> get() const {
+            validate_access<I, Policy>();
+            return _array->_payloads[_position].template get<_Alternative<I>>();
+        }
+
+        template<typename Type, VariantAccessPolicy Policy = VariantAccessPolicy::checked>
+            requires _is_alternative<Type>
+        _Ref<Type> get() const {
+            return get<_index_of<Type>, Policy>();
+        }
+
+        template<typename Type>
+            requires _is_alternative<Type>
+        std::remove_reference_t<_Ref<Type>>* get_if() const noexcept {
+            return holds_alternative<Type>() ? std::addressof(get<Type, VariantAccessPolicy::unchecked>()) : nullptr;
+        }
+
+        template<typename Visitor>
+        decltype(auto) visit(Visitor&& visitor) const {
+            using Result = std::invoke_result_t<Visitor, _Ref<_Alternative<0>>>;
+
+            static_assert((std::is_same_v<Result, std::invoke_result_t<Visitor, _Ref<Types>>> && ...),
+                "Visitor must return the same type for all alternatives");
+
+            return variant_detail::_Dispatch<sizeof...(Types), Result>(index(),
+                [](auto I, const _Element& self, Visitor&& target) -> Result {
+                    return std::invoke(std::forward<Visitor>(target),
+                        self.template get<decltype(I)::value, VariantAccessPolicy::unchecked>());
+                }, *this, std::forward<Visitor>(visitor));
+        }
+
+        // A copy of the element as a Variant.
+        operator Variant<Types...>() const
+            requires meta_functions::_All_copy_constructible<Types...>
+        {
+            return visit([](const auto& alternative) { return Variant<Types...>(alternative); });
+        }
+
+        template<typename Type, typename... Args>
+            requires (!Const) && _is_alternative<Type> && std::is_constructible_v<Type, Args...>
+        Type& emplace(Args&&... args) const {
+            return _array->template _replace<_index_of<Type>>(_position, std::forward<Args>(args)...);
+        }
+
+        // Assigns in place if Type is the active alternative, otherwise
+        // replaces the element.
+        template<typename Type>
+            requires (!Const) && _is_alternative<std::remove_cvref_t<Type>>&&
+                     std::is_constructible_v<std::remove_cvref_t<Type>, Type>&&
+                     std::is_assignable_v<std::remove_cvref_t<Type>&, Type>
+        const _Element& operator=(Type&& value) const {
+            using Pure_type = std::remove_cvref_t<Type>;
+            if (holds_alternative<Pure_type>()) {
+                get<Pure_type, VariantAccessPolicy::unchecked>() = std::forward<Type>(value);
+            }
+            else {
+                emplace<Pure_type>(std::forward<Type>(value));
+            }
+            return *this;
+        }
+    };
+
+public:
+    using reference = _Element<false>;
+    using const_reference = _Element<true>;
+
+    inline static constexpr std::size_t alternatives_count = sizeof...(Types);
+
+    VariantArray() noexcept = default;
+
+    // count copies of value, built in one pass.
+    template<typename Type>
+        requires _is_alternative<Type> && std::is_copy_constructible_v<Type>
+    VariantArray(std::size_t count, const Type& value) {
+        append(count, value);
+    }
+
+    VariantArray(const VariantArray& other)
+        requires meta_functions::_All_copy_constructible<Types...>
+    {
+        reserve(other.size());
+        if constexpr ((std::is_trivially_copyable_v<Types> && ...)) {
+            if (other.size() != 0) {
+                std::memcpy(static_cast<void*>(_payloads), static_cast<const void*>(other._payloads),
+                    other.size() * sizeof(_Payload));
+            }
+            _tags = other._tags;
+        }
+        else {
+            for (std::size_t position = 0; position < other.size(); ++position) {
+                variant_detail::_Dispatch<sizeof...(Types), void>(other._tags[position],
+                    [](auto I, VariantArray& self, const _Payload& source) {
+                        using Type = _Alternative<decltype(I)::value>;
+                        self.template _emplace_back<decltype(I)::value>(source.template get<Type>());
+                    }, *this, other._payloads[position]);
+            }
+        }
+    }
+
+    VariantArray(VariantArray&& other) noexcept
+        : _tags(std::move(other._tags)),
+          _payloads(std::exchange(other._payloads, nullptr)),
+          _capacity(std::exchange(other._capacity, 0)) {
+        other._tags.clear();
+    }
+
+    ~VariantArray() {
+        _destroy_all();
+        if (_payloads != nullptr) {
+            std::allocator<_Payload>().deallocate(_payloads, _capacity);
+        }
+    }
+
+    VariantArray& operator=(const VariantArray& other)
+        requires meta_functions::_All_copy_constructible<Types...>
+    {
+        if (this != std::addressof(other)) {
+            VariantArray copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    VariantArray& operator=(VariantArray&& other) noexcept {
+        VariantArray moved(std::move(other));
+        swap(moved);
+        return *this;
+    }
+
+    void swap(VariantArray& other) noexcept {
+        _tags.swap(other._tags);
+        std::swap(_payloads, other._payloads);
+        std::swap(_capacity, other._capacity);
+    }
+
+    friend void swap(VariantArray& lhs, VariantArray& rhs) noexcept {
+        lhs.swap(rhs);
+    }
+
+public:
+    std::size_t size() const noexcept {
+        return _tags.size();
+    }
+
+    bool empty() const noexcept {
+        return _tags.empty();
+    }
+
+    std::size_t capacity() const noexcept {
+        return _capacity;
+    }
+
+    void reserve(std::size_t capacity) {
+        if (capacity > _capacity) {
+            _reallocate(capacity, [](_Payload*) {});
+        }
+    }
+
+    template<typename Type, typename... Args>
+        requires _is_alternative<Type> && std::is_constructible_v<Type, Args...>
+    Type& emplace_back(Args&&... args) {
+        return _emplace_back<_index_of<Type>>(std::forward<Args>(args)...);
+    }
+
+    template<size_t I, typename... Args>
+        requires meta_functions::_Is_index_of_alternative<I, Types...>&&
+                 std::is_constructible_v<_Alternative<I>, Args...>
+    _Alternative<I>& emplace_back(Args&&... args) {
+        return _emplace_back<I>(std::forward<Args>(args)...);
+    }
+
+    template<typename Type>
+        requires _is_alternative<std::remove_cvref_t<Type>>&&
+                 std::is_constructible_v<std::remove_cvref_t<Type>, Type>
+    void push_back(Type&& value) {
+        _emplace_back<_index_of<std::remove_cvref_t<Type>>>(std::forward<Type>(value));
+    }
+
+    // Appends the active alternative of variant. Throws, like visit, if
+    // variant is valueless.
+    template<typename Source>
+        requires std::is_same_v<std::remove_cvref_t<Source>, Variant<Types...>>
+    void push_back(Source&& variant) {
+        std::forward<Source>(variant).visit([this]<typename Alternative>(Alternative&& alternative) {
+            push_back(std::forward<Alternative>(alternative));
+        });
+    }
+
+    // Appends count copies of value: one reallocation, one fill of the tag
+    // column, and a plain fill of the payloads when Type is trivially
+    // copyable.
+    template<typename Type>
+        requires _is_alternative<Type> && std::is_copy_constructible_v<Type>
+    void append(std::size_t count, const Type& value) {
+        if (count == 0) {
+            return;
+        }
+        if (size() + count > _capacity) {
+            const Type copy(value);
+            reserve(std::max(size() + count, _grown_capacity(size() + 1)));
+            _append_copies(count, copy);
+        }
+        else {
+            _append_copies(count, value);
+        }
+    }
+
+    void pop_back() noexcept {
+        assert(!empty() && "VariantArray::pop_back: the array is empty");
+        _destroy(size() - 1);
+        _tags.pop_back();
+    }
+
+    void clear() noexcept {
+        _destroy_all();
+        _tags.clear();
+    }
+
+public:
+    reference operator[](std::size_t position) noexcept {
+        assert(position < size() && "VariantArray: position out of range");
+        return reference(*this, position);
+    }
+
+    const_reference operator[](std::size_t position) const noexcept {
+        assert(position < size() && "VariantArray: position out of range");
+        return const_reference(*this, position);
+    }
+
+    std::size_t index(std::size_t position) const noexcept {
+        assert(position < size() && "VariantArray: position out of range");
+        return _tags[position];
+    }
+
+    // The tag column: the index of every element, in order.
+    std::span<const tag_type> tags() const noexcept {
+        return _tags;
+    }
+
+    template<typename Type>
+        requires _is_alternative<Type>
+    std::size_t count() const noexcept {
+        return count(_index_of<Type>);
+    }
+
+    std::size_t count(std::size_t index) const noexcept {
+        if (index >= sizeof...(Types)) {
+            return 0;
+        }
+        if constexpr (_byte_tags) {
+            return variant_detail::_Count_tag(_tags.data(), size(), static_cast<std::uint8_t>(index));
+        }
+        else {
+            return static_cast<std::size_t>(std::count(_tags.begin(), _tags.end(), static_cast<tag_type>(index)));
+        }
+    }
+
+    // The number of elements holding each alternative.
+    std::array<std::size_t, sizeof...(Types)> histogram() const noexcept {
+        std::array<std::size_t, sizeof...(Types)> counts{};
+        if constexpr (_byte_tags) {
+            variant_detail::_Tag_histogram<sizeof...(Types)>(_tags.data(), size(), counts.data());
+        }
+        else {
+            for (const tag_type tag : _tags) {
+                ++counts[tag];
+            }
+        }
+        return counts;
+    }
+
+public:
+    // Calls visitor with every element's active alternative, in order.
+    template<typename Visitor>
+    void for_each(Visitor&& visitor) {
+        _for_each_impl(*this, visitor);
+    }
+
+    template<typename Visitor>
+    void for_each(Visitor&& visitor) const {
+        _for_each_impl(*this, visitor);
+    }
+
+    // Calls visitor with each element that holds Type, in order, reading
+    // the payload column only for those elements.
+    template<typename Type, typename Visitor>
+        requires _is_alternative<Type>
+    void for_each_of(Visitor&& visitor) {
+        _for_each_of_impl<Type>(*this, visitor);
+    }
+
+    template<typename Type, typename Visitor>
+        requires _is_alternative<Type>
+    void for_each_of(Visitor&& visitor) const {
+        _for_each_of_impl<Type>(*this, visitor);
+    }
+
+private:
+    template<typename Type>
+    void _append_copies(std::size_t count, const Type& value) {
+        _Payload* first = _payloads + size();
+        if constexpr (std::is_trivially_copyable_v<Type>) {
+            for (std::size_t i = 0; i < count; ++i) {
+                _create<_index_of<Type>>(first + i, value);
+            }
+            _tags.resize(size() + count, static_cast<tag_type>(_index_of<Type>));
+        }
+        else {
+            // Tags go in one by one, so a throwing copy leaves the copies
+            // already made in the array.
+            for (std::size_t i = 0; i < count; ++i) {
+                _create<_index_of<Type>>(first + i, value);
+                _tags.push_back(static_cast<tag_type>(_index_of<Type>));
+            }
+        }
+    }
+
+    // The payloads of a const array are read as const.
+    template<typename Self>
+    using _Payload_ref = std::conditional_t<std::is_const_v<Self>, const _Payload&, _Payload&>;
+
+    template<typename Self, typename Visitor>
+    static void _for_each_impl(Self& self, Visitor& visitor) {
+        for (std::size_t position = 0; position < self.size(); ++position) {
+            _Payload_ref<Self> payload = self._payloads[position];
+            variant_detail::_Dispatch<sizeof...(Types), void>(self._tags[position],
+                [](auto I, _Payload_ref<Self> source, Visitor& target) {
+                    std::invoke(target, source.template get<_Alternative<decltype(I)::value>>());
+                }, payload, visitor);
+        }
+    }
+
+    template<typename Type, typename Self, typename Visitor>
+    static void _for_each_of_impl(Self& self, Visitor& visitor) {
+        constexpr auto tag = static_cast<tag_type>(_index_of<Type>);
+        if constexpr (_byte_tags) {
+            const std::uint8_t* tags = self._tags.data();
+            for (std::size_t position = variant_detail::_Find_tag(tags, self.size(), 0, tag);
+                 position < self.size();
+                 position = variant_detail::_Find_tag(tags, self.size(), position + 1, tag)) {
+                _Payload_ref<Self> payload = self._payloads[position];
+                std::invoke(visitor, payload.template get<Type>());
+            }
+        }
+        else {
+            for (std::size_t position = 0; position < self.size(); ++position) {
+                if (self._tags[position] == tag) {
+                    _Payload_ref<Self> payload = self._payloads[position];
+                    std::invoke(visitor, payload.template get<Type>());
+                }
+            }
+        }
+    }
+};
@@ -0,0 +1,260 @@
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Variant.hpp"
+
+namespace variant_detail {
+    // Segment of bool alternatives. std::vector<bool> packs its elements into
+    // bits and hands out proxies instead of bool&, so it could back neither
+    // segment<bool>() nor a for_each that modifies the elements; this buffer
+    // keeps one bool per byte and offers the part of the std::vector
+    // interface VariantCollection uses.
+    class _Bool_segment {
+    private:
+        bool* _data = nullptr;
+        std::size_t _size = 0;
+        std::size_t _capacity = 0;
+
+        constexpr void _reallocate(std::size_t capacity) {
+            std::allocator<bool> allocator;
+            bool* data = allocator.allocate(capacity);
+            for (std::size_t i = 0; i < _size; ++i) {
+                std::construct_at(data + i, _data[i]);
+            }
+            if (_data != nullptr) {
+                allocator.deallocate(_data, _capacity);
+            }
+            _data = data;
+            _capacity = capacity;
+        }
+
+    public:
+        constexpr _Bool_segment() noexcept = default;
+
+        constexpr _Bool_segment(const _Bool_segment& other) {
+            reserve(other._size);
+            for (const bool element : other) {
+                emplace_back(element);
+            }
+        }
+
+        constexpr _Bool_segment(_Bool_segment&& other) noexcept
+            : _data(std::exchange(other._data, nullptr)),
+              _size(std::exchange(other._size, 0)),
+              _capacity(std::exchange(other._capacity, 0)) {}
+
+        constexpr _Bool_segment& operator=(_Bool_segment other) noexcept {
+            std::swap(_data, other._data);
+            std::swap(_size, other._size);
+            std::swap(_capacity, other._capacity);
+            return *this;
+        }
+
+        constexpr ~_Bool_segment() {
+            if (_data != nullptr) {
+                std::allocator<bool>().deallocate(_data, _capacity);
+            }
+        }
+
+        constexpr bool* begin() noexcept { return _data; }
+        constexpr const bool* begin() const noexcept { return _data; }
+        constexpr bool* end() noexcept { return _data + _size; }
+        constexpr const bool* end() const noexcept { return _data + _size; }
+        constexpr std::size_t size() const noexcept { return _size; }
+
+        constexpr void reserve(std::size_t capacity) {
+            if (capacity > _capacity) {
+                _reallocate(capacity);
+            }
+        }
+
+        template<typename... Args>
+        constexpr bool& emplace_back(Args&&... args) {
+            if (_size == _capacity) {
+                _reallocate(_capacity == 0 ? 8 : 2 * _capacity);
+            }
+            bool& element = *std::construct_at(_data + _size, std::forward<Args>(args)...);
+            ++_size;
+            return element;
+        }
+
+        constexpr bool* erase(bool* first, bool* last) noexcept {
+            std::copy(last, end(), first);
+            _size -= static_cast<std::size_t>(last - first);
+            return first;
+        }
+
+        constexpr bool* erase(bool* position) noexcept {
+            return erase(position, position + 1);
+        }
+
+        constexpr void clear() noexcept {
+            _size = 0;
+        }
+    };
+
+    template<typename Type>
+    using _Segment_t = std::conditional_t<std::is_same_v<Type, bool>, _Bool_segment, std::vector<Type>>;
+}
+
+
+// A collection of Variant<Types...> values kept apart by alternative: every
+// alternative has its own contiguous segment, so a pass over the collection
+// walks one array of a single type after another and calls the visitor for
+// each with no dispatch on an index. Elements keep their insertion order
+// within their segment; the order across segments is the order of Types.
+// As with std::vector, inserting into or erasing from a segment invalidates
+// references into that segment only.
+template<typename... Types>
+    requires meta_functions::_Is_pack_of_different_type<Types...>&&
+             meta_functions::_Is_pack_not_empty<Types...>&&
+             ((std::is_object_v<Types> && !std::is_array_v<Types> && !std::is_const_v<Types> &&
+               std::is_move_constructible_v<Types>) && ...)
+class VariantCollection final {
+private:
+    template<typename Type>
+    inline static constexpr std::size_t _index_of = meta_functions::_Get_index_v<Type, Types...>;
+
+    template<typename Type>
+    inline static constexpr bool _is_alternative = meta_functions::_Is_type_present<Type, Types...>;
+
+    std::tuple<variant_detail::_Segment_t<Types>...> _segments;
+
+    template<typename Type>
+    constexpr variant_detail::_Segment_t<Type>& _segment() noexcept {
+        return std::get<_index_of<Type>>(_segments);
+    }
+
+    template<typename Type>
+    constexpr const variant_detail::_Segment_t<Type>& _segment() const noexcept {
+        return std::get<_index_of<Type>>(_segments);
+    }
+
+    template<typename Self, typename Visitor>
+    static constexpr void _for_each_impl(Self& self, Visitor& visitor) {
+        std::apply([&visitor](auto&... segments) {
+            ([&visitor](auto& segment) {
+                for (auto& element : segment) {
+                    std::invoke(visitor, element);
+                }
+            }(segments), ...);
+        }, self._segments);
+    }
+
+public:
+    using variant_type = Variant<Types...>;
+
+    inline static constexpr std::size_t alternatives_count = sizeof...(Types);
+
+    constexpr VariantCollection() = default;
+
+public:
+    template<typename Type, typename... Args>
+        requires _is_alternative<Type>&& std::is_constructible_v<Type, Args...>
+    constexpr Type& emplace(Args&&... args) {
+        return _segment<Type>().emplace_back(std::forward<Args>(args)...);
+    }
+
+    template<typename Type>
+        requires _is_alternative<std::remove_cvref_t<Type>>&&
+                 std::is_constructible_v<std::remove_cvref_t<Type>, Type>
+    constexpr std::remove_cvref_t<Type>& insert(Type&& value) {
+        return emplace<std::remove_cvref_t<Type>>(std::forward<Type>(value));
+    }
+
+    // Adds the active alternative of variant to its segment. Throws, like
+    // visit, if variant is valueless.
+    template<typename Source>
+        requires std::is_same_v<std::remove_cvref_t<Source>, variant_type>
+    constexpr void insert(Source&& variant) {
+        std::forward<Source>(variant).visit([this]<typename Alternative>(Alternative&& alternative) {
+            insert(std::forward<Alternative>(alternative));
+        });
+    }
+
+    // Removes the element at position in the segment of Type, keeping the
+    // order of the rest.
+    template<typename Type>
+        requires _is_alternative<Type>
+    constexpr void erase(std::size_t position) {
+        variant_detail::_Segment_t<Type>& segment = _segment<Type>();
+        assert(position < segment.size() && "VariantCollection::erase: position out of range");
+        segment.erase(segment.begin() + static_cast<std::ptrdiff_t>(position));
+    }
+
+    // Removes every element for which predicate, called with the element as
+    // for_each would, returns true. Returns the number removed.
+    template<typename Predicate>
+        requires (std::is_invocable_r_v<bool, Predicate&, const Types&> && ...)
+    constexpr std::size_t erase_if(Predicate predicate) {
+        return std::apply([&predicate](auto&... segments) {
+            return ([&predicate](auto& segment) {
+                const auto kept_end = std::remove_if(segment.begin(), segment.end(),
+                    [&predicate](const auto& element) -> bool {
+                        return std::invoke(predicate, element);
+                    });
+                const auto removed = static_cast<std::size_t>(segment.end() - kept_end);
+                segment.erase(kept_end, segment.end());
+                return removed;
+            }(segments) + ... + std::size_t(0));
+        }, _segments);
+    }
+
+    constexpr void clear() noexcept {
+        std::apply([](auto&... segments) { (segments.clear(), ...); }, _segments);
+    }
+
+    template<typename Type>
+        requires _is_alternative<Type>
+    constexpr void reserve(std::size_t capacity) {
+        _segment<Type>().reserve(capacity);
+    }
+
+public:
+    constexpr std::size_t size() const noexcept {
+        return std::apply([](const auto&... segments) { return (segments.size() + ...); }, _segments);
+    }
+
+    template<typename Type>
+        requires _is_alternative<Type>
+    constexpr std::size_t size() const noexcept {
+        return _segment<Type>().size();
+    }
+
+    constexpr bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    template<typename Type>
+        requires _is_alternative<Type>
+    constexpr std::span<Type> segment() noexcept {
+        return _segment<Type>();
+    }
+
+    template<typename Type>
+        requires _is_alternative<Type>
+    constexpr std::span<const Type> segment() const noexcept {
+        return _segment<Type>();
+    }
+
+public:
+    // Calls visitor with every element, one segment at a time. The visitor
+    // is called once per element type, so it needs no common return type.
+    template<typename Visitor>
+    constexpr void for_each(Visitor&& visitor) {
+        _for_each_impl(*this, visitor);
+    }
+
+    template<typename Visitor>
+    constexpr void for_each(Visitor&& visitor) const {
+        _for_each_impl(*this, visitor);
+    }
+};
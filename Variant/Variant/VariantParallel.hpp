@@ -0,0 +1,109 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../detail/ThreadPool.hpp"
+#include "VariantAlgorithms.hpp"
+
+
+// Visitation spread over threads, for contiguous ranges of Variants too
+// large for one core. The range is cut into chunks of about
+// variant_detail::_Parallel_chunk_bytes, which a VariantThreadPool hands out
+// to its threads; a thread that finishes its share steals chunks from the
+// others, so alternatives with unequal visiting costs do not leave threads
+// idle. Without a pool, VariantThreadPool::shared() is used.
+using VariantThreadPool = variant_detail::_Thread_pool;
+
+namespace variant_detail {
+    // Small enough that a chunk stays in the L2 cache of the core visiting
+    // it, large enough that taking it costs next to nothing.
+    inline constexpr std::size_t _Parallel_chunk_bytes = 64 * 1024;
+
+    template<typename Range>
+    concept _Contiguous_variant_range = _Variant_range<Range> &&
+        std::ranges::contiguous_range<Range> && std::ranges::sized_range<Range>;
+
+    template<typename Range>
+    inline constexpr std::size_t _Parallel_chunk_size =
+        std::max<std::size_t>(_Parallel_chunk_bytes / sizeof(std::ranges::range_value_t<Range>), 1);
+
+    template<typename Range>
+    std::size_t _Parallel_chunk_count(Range& range) {
+        return (std::ranges::size(range) + _Parallel_chunk_size<Range> - 1) / _Parallel_chunk_size<Range>;
+    }
+
+    // Calls body with the span of elements and the number of every chunk of
+    // range, on pool.
+    template<typename Range, typename Body>
+    void _Run_chunks(VariantThreadPool& pool, Range& range, Body body) {
+        const std::span elements(std::ranges::data(range), std::ranges::size(range));
+        auto chunk_body = [&elements, &body](std::size_t chunk) {
+            const std::size_t first = chunk * _Parallel_chunk_size<Range>;
+            body(elements.subspan(first, std::min(_Parallel_chunk_size<Range>, elements.size() - first)), chunk);
+        };
+        pool.run(_Parallel_chunk_count(range), chunk_body);
+    }
+}
+
+// Calls visitor with the active alternative of every element, like visit,
+// on the threads of pool. Elements are visited in no particular order and
+// the visitor is shared by all threads, so it must be safe to call
+// concurrently. Fails like visit if an element is valueless, once the chunks
+// already started have finished.
+template<typename Range, typename Visitor>
+    requires variant_detail::_Contiguous_variant_range<Range>
+void parallel_visit(VariantThreadPool& pool, Range&& range, Visitor&& visitor) {
+    variant_detail::_Run_chunks(pool, range, [&visitor](auto elements, std::size_t) {
+        for (auto& element : elements) {
+            element.visit(visitor);
+        }
+    });
+}
+
+template<typename Range, typename Visitor>
+    requires variant_detail::_Contiguous_variant_range<Range>
+void parallel_visit(Range&& range, Visitor&& visitor) {
+    parallel_visit(VariantThreadPool::shared(), range, visitor);
+}
+
+// Like std::transform_reduce: reduces with init the results of transform,
+// called with the active alternative of every element and converted to
+// Type. Each chunk is reduced in order on one thread, and the results of the
+// chunks are then reduced into init in range order, so with an associative
+// reduce the result does not depend on the number of threads.
+template<typename Range, typename Type, typename Reduce, typename Transform>
+    requires variant_detail::_Contiguous_variant_range<Range> && std::is_move_constructible_v<Type>
+Type parallel_transform_reduce(VariantThreadPool& pool, Range&& range, Type init, Reduce reduce, Transform transform) {
+    auto apply = [&transform](auto& element) -> Type {
+        return element.visit([&transform](auto& alternative) -> Type {
+            return std::invoke(transform, alternative);
+        });
+    };
+
+    std::vector<std::optional<Type>> partials(variant_detail::_Parallel_chunk_count(range));
+    variant_detail::_Run_chunks(pool, range, [&](auto elements, std::size_t chunk) {
+        Type partial = apply(elements[0]);
+        for (std::size_t position = 1; position < elements.size(); ++position) {
+            partial = std::invoke(reduce, std::move(partial), apply(elements[position]));
+        }
+        partials[chunk].emplace(std::move(partial));
+    });
+
+    for (std::optional<Type>& partial : partials) {
+        init = std::invoke(reduce, std::move(init), std::move(*partial));
+    }
+    return init;
+}
+
+template<typename Range, typename Type, typename Reduce, typename Transform>
+    requires variant_detail::_Contiguous_variant_range<Range> && std::is_move_constructible_v<Type>
+Type parallel_transform_reduce(Range&& range, Type init, Reduce reduce, Transform transform) {
+    return parallel_transform_reduce(VariantThreadPool::shared(), range, std::move(init),
+        std::move(reduce), std::move(transform));
+}
@@ -0,0 +1,101 @@
+#pragma once
+#include <atomic>
+#include <cstdlib>
+#include <variant>
+
+// Defined automatically when the compiler has exceptions disabled; define it
+// explicitly to get the same behavior in a build that has them. A failed
+// access then calls the handler installed with set_bad_variant_access_handler
+// and aborts, instead of throwing std::bad_variant_access.
+#if !defined(VARIANT_NO_EXCEPTIONS) && \
+    !defined(__cpp_exceptions) && !defined(__EXCEPTIONS) && !defined(_CPPUNWIND)
+#define VARIANT_NO_EXCEPTIONS
+#endif
+
+enum class VariantAccessError : unsigned char {
+    valueless,
+    wrong_alternative
+};
+
+using BadVariantAccessHandler = void (*)(VariantAccessError);
+
+// How Variant::get verifies that the requested alternative is active:
+// checked fails like a bad access (throws, or calls the handler), asserting
+// only asserts in builds without NDEBUG, and unchecked tells the optimizer to
+// assume it, so calling get on an inactive alternative is undefined behavior.
+// The latter two are meant for code that already knows the active index.
+enum class VariantAccessPolicy : unsigned char {
+    checked,
+    asserting,
+    unchecked
+};
+
+namespace variant_detail {
+    inline std::atomic<BadVariantAccessHandler> _Bad_access_handler{ nullptr };
+
+    [[noreturn]] inline void _Throw_bad_access([[maybe_unused]] VariantAccessError error) {
+#ifdef VARIANT_NO_EXCEPTIONS
+        if (const BadVariantAccessHandler handler = _Bad_access_handler.load()) {
+            handler(error);
+        }
+        std::abort();
+#else
+        throw std::bad_variant_access();
+#endif
+    }
+}
+
+// Installs the handler called before aborting on a failed access when built
+// with VARIANT_NO_EXCEPTIONS, and returns the previous one. The handler may
+// log or terminate on its own; if it returns, the program aborts.
+inline BadVariantAccessHandler set_bad_variant_access_handler(BadVariantAccessHandler handler) noexcept {
+    return variant_detail::_Bad_access_handler.exchange(handler);
+}
+
+// Result of Variant::try_get: a reference to the requested alternative, or the
+// reason it is not available.
+template<typename Type>
+class VariantAccessResult {
+public:
+    constexpr VariantAccessResult(Type& value) noexcept : _value(&value) {}
+
+    constexpr VariantAccessResult(VariantAccessError error) noexcept : _error(error) {}
+
+    constexpr bool has_value() const noexcept {
+        return _value != nullptr;
+    }
+
+    constexpr explicit operator bool() const noexcept {
+        return has_value();
+    }
+
+    // The alternative, or the same failure as Variant::get if there is none.
+    constexpr Type& value() const {
+        if (!has_value()) {
+            variant_detail::_Throw_bad_access(_error);
+        }
+        return *_value;
+    }
+
+    constexpr Type& operator*() const noexcept {
+        return *_value;
+    }
+
+    constexpr Type* operator->() const noexcept {
+        return _value;
+    }
+
+    // Pointer to the alternative, or nullptr.
+    constexpr Type* get() const noexcept {
+        return _value;
+    }
+
+    // Meaningful only when has_value() is false.
+    constexpr VariantAccessError error() const noexcept {
+        return _error;
+    }
+
+private:
+    Type* _value = nullptr;
+    VariantAccessError _error = VariantAccessError::wrong_alternative;
+};
@@ -0,0 +1,52 @@
+#pragma once
+#include <memory>
+#include <type_traits>
+
+namespace variant_detail {
+    // Allocator of a Variant none of whose alternatives takes one. No
+    // allocator converts to it, so std::uses_allocator is false for such a
+    // Variant.
+    struct _No_allocator {};
+
+    template<typename Type>
+    concept _Allocator_aware = requires { typename Type::allocator_type; } &&
+        !std::is_same_v<typename Type::allocator_type, _No_allocator> &&
+        std::uses_allocator_v<Type, typename Type::allocator_type>;
+
+    // The allocator_type of the first alternative that has one.
+    template<typename... Types>
+    struct _Common_allocator {
+        using type = _No_allocator;
+    };
+
+    template<typename First, typename... Rest>
+    struct _Common_allocator<First, Rest...> : _Common_allocator<Rest...> {};
+
+    template<typename First, typename... Rest>
+        requires _Allocator_aware<First>
+    struct _Common_allocator<First, Rest...> {
+        using type = typename First::allocator_type;
+    };
+
+    template<typename... Types>
+    using _Common_allocator_t = typename _Common_allocator<Types...>::type;
+
+    template<typename Allocator>
+    constexpr Allocator _Select_on_copy(const Allocator& allocator) {
+        if constexpr (std::is_same_v<Allocator, _No_allocator>) {
+            return allocator;
+        }
+        else {
+            return std::allocator_traits<Allocator>::select_on_container_copy_construction(allocator);
+        }
+    }
+
+    // Whether uses-allocator construction of Type from args cannot throw:
+    // the leading allocator_arg_t convention is preferred, as in
+    // std::uses_allocator_construction_args.
+    template<typename Type, typename Allocator, typename... Args>
+    inline constexpr bool _Is_nothrow_uses_allocator_constructible_v =
+        std::is_constructible_v<Type, std::allocator_arg_t, const Allocator&, Args...>
+            ? std::is_nothrow_constructible_v<Type, std::allocator_arg_t, const Allocator&, Args...>
+            : std::is_nothrow_constructible_v<Type, Args..., const Allocator&>;
+}
@@ -0,0 +1,160 @@
+#pragma once
+#include <cstddef>
+#include <mutex>
+#include <new>
+
+namespace variant_detail {
+    // Size-class allocator behind Boxed. Requests of up to max_size bytes are
+    // rounded up to a multiple of granularity and served from a per-thread
+    // free list of that class. The per-thread lists trade blocks with shared
+    // ones in batches, so a queue whose producer allocates and whose consumer
+    // frees on another thread reuses the same blocks instead of growing. New
+    // blocks are carved from chunks that are never returned to the system.
+    // Larger and over-aligned requests go to operator new.
+    class _Box_pool {
+    public:
+        static constexpr std::size_t granularity = 16;
+        static constexpr std::size_t max_size = 1024;
+        static constexpr std::size_t batch = 32;
+
+        static constexpr bool is_pooled(std::size_t size, std::size_t alignment) noexcept {
+            return size <= max_size && alignment <= granularity &&
+                alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+        }
+
+        static void* allocate(std::size_t size, std::size_t alignment) {
+            if (!is_pooled(size, alignment)) {
+                return ::operator new(size, std::align_val_t(alignment));
+            }
+            const std::size_t size_class = _size_class(size);
+            if (_local_state() == _State::destroyed) {
+                // A whole block, so that it can join the lists when freed.
+                return ::operator new((size_class + 1) * granularity);
+            }
+            _Local& local = _local();
+            if (local.free[size_class] == nullptr) {
+                _refill(local, size_class);
+            }
+            _Block* block = local.free[size_class];
+            local.free[size_class] = block->next;
+            --local.count[size_class];
+            return block;
+        }
+
+        static void deallocate(void* pointer, std::size_t size, std::size_t alignment) noexcept {
+            if (!is_pooled(size, alignment)) {
+                ::operator delete(pointer, size, std::align_val_t(alignment));
+                return;
+            }
+            const std::size_t size_class = _size_class(size);
+            _Block* block = ::new (pointer) _Block{ nullptr };
+            if (_local_state() == _State::destroyed) {
+                // The thread is exiting and its list is gone.
+                _Shared& shared = _shared();
+                std::lock_guard lock(shared.mutex);
+                block->next = shared.free[size_class];
+                shared.free[size_class] = block;
+                return;
+            }
+            _Local& local = _local();
+            block->next = local.free[size_class];
+            local.free[size_class] = block;
+            if (++local.count[size_class] > 2 * batch) {
+                _spill(local, size_class, batch);
+            }
+        }
+
+    private:
+        struct _Block {
+            _Block* next;
+        };
+
+        static constexpr std::size_t _classes = max_size / granularity;
+
+        struct _Shared {
+            std::mutex mutex;
+            _Block* free[_classes] = {};
+        };
+
+        enum class _State : unsigned char { unused, alive, destroyed };
+
+        struct _Local {
+            _Block* free[_classes] = {};
+            std::size_t count[_classes] = {};
+
+            _Local() noexcept {
+                _local_state() = _State::alive;
+            }
+
+            // Hands every cached block to the shared lists.
+            ~_Local() {
+                for (std::size_t size_class = 0; size_class < _classes; ++size_class) {
+                    _spill(*this, size_class, count[size_class]);
+                }
+                _local_state() = _State::destroyed;
+            }
+        };
+
+        static std::size_t _size_class(std::size_t size) noexcept {
+            return size == 0 ? 0 : (size - 1) / granularity;
+        }
+
+        static _Shared& _shared() noexcept {
+            static _Shared shared;
+            return shared;
+        }
+
+        // Trivially destructible, so it can still be read while the thread's
+        // _Local is being destroyed and after.
+        static _State& _local_state() noexcept {
+            thread_local _State state = _State::unused;
+            return state;
+        }
+
+        static _Local& _local() noexcept {
+            thread_local _Local local;
+            return local;
+        }
+
+        // Takes up to a batch from the shared list, or carves a new chunk of
+        // a batch of blocks when the shared list is empty.
+        static void _refill(_Local& local, std::size_t size_class) {
+            {
+                _Shared& shared = _shared();
+                std::lock_guard lock(shared.mutex);
+                while (shared.free[size_class] != nullptr && local.count[size_class] < batch) {
+                    _Block* block = shared.free[size_class];
+                    shared.free[size_class] = block->next;
+                    block->next = local.free[size_class];
+                    local.free[size_class] = block;
+                    ++local.count[size_class];
+                }
+            }
+            if (local.free[size_class] != nullptr) {
+                return;
+            }
+
+            const std::size_t block_size = (size_class + 1) * granularity;
+            std::byte* chunk = static_cast<std::byte*>(::operator new(block_size * batch));
+            for (std::size_t i = batch; i-- > 0;) {
+                local.free[size_class] = ::new (chunk + i * block_size) _Block{ local.free[size_class] };
+            }
+            local.count[size_class] = batch;
+        }
+
+        static void _spill(_Local& local, std::size_t size_class, std::size_t count) noexcept {
+            if (count == 0) {
+                return;
+            }
+            _Shared& shared = _shared();
+            std::lock_guard lock(shared.mutex);
+            for (std::size_t i = 0; i < count; ++i) {
+                _Block* block = local.free[size_class];
+                local.free[size_class] = block->next;
+                block->next = shared.free[size_class];
+                shared.free[size_class] = block;
+            }
+            local.count[size_class] -= count;
+        }
+    };
+}
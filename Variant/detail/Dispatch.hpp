@@ -0,0 +1,179 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace variant_detail {
+    [[noreturn]] inline void _Unreachable() noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+        __assume(false);
+#else
+        __builtin_unreachable();
+#endif
+    }
+
+    // Lets the optimizer rely on condition; it must be true. Constant
+    // evaluation diagnoses the invalid access that follows instead.
+    constexpr void _Assume(bool condition) noexcept {
+        if (std::is_constant_evaluated()) {
+            return;
+        }
+#if defined(__clang__)
+        __builtin_assume(condition);
+#elif defined(_MSC_VER)
+        __assume(condition);
+#else
+        if (!condition) {
+            _Unreachable();
+        }
+#endif
+    }
+
+    template<std::size_t I>
+    using _Index_constant = std::integral_constant<std::size_t, I>;
+
+    // Packs up to _Switch_width alternatives are dispatched through one switch,
+    // packs up to _Switch_width squared through two nested switches, and larger
+    // ones through a table of function pointers indexed by the alternative index.
+    // Switches let the compiler inline every case; the table costs an indirect call.
+    inline constexpr std::size_t _Switch_width = 8;
+
+    template<typename Result, std::size_t I, typename Func, typename... Args>
+    constexpr Result _Dispatch_thunk(Func&& func, Args&&... args) {
+        return std::forward<Func>(func)(_Index_constant<I>{}, std::forward<Args>(args)...);
+    }
+
+    template<typename Result, typename Sequence, typename Func, typename... Args>
+    struct _Dispatch_table;
+
+    template<typename Result, std::size_t... Is, typename Func, typename... Args>
+    struct _Dispatch_table<Result, std::index_sequence<Is...>, Func, Args...> {
+        static constexpr Result(*_value[])(Func&&, Args&&...) = {
+            &_Dispatch_thunk<Result, Is, Func, Args...>...
+        };
+    };
+
+    template<std::size_t I, std::size_t N, typename Result, typename Func, typename... Args>
+    constexpr Result _Switch_case(Func&& func, Args&&... args) {
+        if constexpr (I < N) {
+            return std::forward<Func>(func)(_Index_constant<I>{}, std::forward<Args>(args)...);
+        }
+        else {
+            _Unreachable();
+        }
+    }
+
+    // Dispatches indices Base .. Base + _Switch_width - 1; offset is index - Base.
+    template<std::size_t Base, std::size_t N, typename Result, typename Func, typename... Args>
+    constexpr Result _Switch_block(std::size_t offset, Func&& func, Args&&... args) {
+        if constexpr (Base < N) {
+            switch (offset) {
+            case 0: return _Switch_case<Base + 0, N, Result>(std::forward<Func>(func), std::forward<Args>(args)...);
+            case 1: return _Switch_case<Base + 1, N, Result>(std::forward<Func>(func), std::forward<Args>(args)...);
+            case 2: return _Switch_case<Base + 2, N, Result>(std::forward<Func>(func), std::forward<Args>(args)...);
+            case 3: return _Switch_case<Base + 3, N, Result>(std::forward<Func>(func), std::forward<Args>(args)...);
+            case 4: return _Switch_case<Base + 4, N, Result>(std::forward<Func>(func), std::forward<Args>(args)...);
+            case 5: return _Switch_case<Base + 5, N, Result>(std::forward<Func>(func), std::forward<Args>(args)...);
+            case 6: return _Switch_case<Base + 6, N, Result>(std::forward<Func>(func), std::forward<Args>(args)...);
+            case 7: return _Switch_case<Base + 7, N, Result>(std::forward<Func>(func), std::forward<Args>(args)...);
+            default: _Unreachable();
+            }
+        }
+        else {
+            _Unreachable();
+        }
+    }
+
+    // Calls func(_Index_constant<index>{}, args...). The index must be less than N.
+    // The arguments are passed through rather than captured, so the selected
+    // case reaches them without an extra indirection.
+    template<std::size_t N, typename Result, typename Func, typename... Args>
+    constexpr Result _Dispatch(std::size_t index, Func&& func, Args&&... args) {
+        constexpr std::size_t W = _Switch_width;
+        if constexpr (N <= W) {
+            return _Switch_block<0, N, Result>(index, std::forward<Func>(func), std::forward<Args>(args)...);
+        }
+        else if constexpr (N <= W * W) {
+            const std::size_t offset = index % W;
+            switch (index / W) {
+            case 0: return _Switch_block<0 * W, N, Result>(offset, std::forward<Func>(func), std::forward<Args>(args)...);
+            case 1: return _Switch_block<1 * W, N, Result>(offset, std::forward<Func>(func), std::forward<Args>(args)...);
+            case 2: return _Switch_block<2 * W, N, Result>(offset, std::forward<Func>(func), std::forward<Args>(args)...);
+            case 3: return _Switch_block<3 * W, N, Result>(offset, std::forward<Func>(func), std::forward<Args>(args)...);
+            case 4: return _Switch_block<4 * W, N, Result>(offset, std::forward<Func>(func), std::forward<Args>(args)...);
+            case 5: return _Switch_block<5 * W, N, Result>(offset, std::forward<Func>(func), std::forward<Args>(args)...);
+            case 6: return _Switch_block<6 * W, N, Result>(offset, std::forward<Func>(func), std::forward<Args>(args)...);
+            case 7: return _Switch_block<7 * W, N, Result>(offset, std::forward<Func>(func), std::forward<Args>(args)...);
+            default: _Unreachable();
+            }
+        }
+        else {
+            return _Dispatch_table<Result, std::make_index_sequence<N>, Func, Args...>::_value[index](
+                std::forward<Func>(func), std::forward<Args>(args)...);
+        }
+    }
+
+    // Several indices are combined into one mixed-radix index, so visiting N
+    // variants costs a single dispatch over the product of their sizes.
+    template<std::size_t... Sizes>
+    constexpr std::size_t _Flatten_index(const std::array<std::size_t, sizeof...(Sizes)>& indices) noexcept {
+        constexpr std::size_t sizes[] = { Sizes... };
+        std::size_t flat = 0;
+        for (std::size_t dim = 0; dim < sizeof...(Sizes); ++dim) {
+            flat = flat * sizes[dim] + indices[dim];
+        }
+        return flat;
+    }
+
+    template<std::size_t Flat, std::size_t Dim, std::size_t... Sizes>
+    constexpr std::size_t _Unflatten_index() noexcept {
+        constexpr std::size_t sizes[] = { Sizes... };
+        std::size_t stride = 1;
+        for (std::size_t dim = Dim + 1; dim < sizeof...(Sizes); ++dim) {
+            stride *= sizes[dim];
+        }
+        return Flat / stride % sizes[Dim];
+    }
+
+    template<std::size_t Flat, typename Dims, std::size_t... Sizes>
+    struct _Unflattened;
+
+    template<std::size_t Flat, std::size_t... Dims, std::size_t... Sizes>
+    struct _Unflattened<Flat, std::index_sequence<Dims...>, Sizes...> {
+        using type = std::index_sequence<_Unflatten_index<Flat, Dims, Sizes...>()...>;
+    };
+
+    // Calls func(std::index_sequence<indices[0], indices[1], ...>{}, args...).
+    template<typename Result, std::size_t... Sizes, typename Func, typename... Args>
+    constexpr Result _Multi_dispatch(const std::array<std::size_t, sizeof...(Sizes)>& indices,
+        Func&& func, Args&&... args) {
+        return _Dispatch<(Sizes * ... * 1), Result>(_Flatten_index<Sizes...>(indices),
+            [](auto Flat, Func&& target, Args&&... target_args) -> Result {
+                using Indices = typename _Unflattened<decltype(Flat)::value,
+                    std::make_index_sequence<sizeof...(Sizes)>, Sizes...>::type;
+                return std::forward<Func>(target)(Indices{}, std::forward<Args>(target_args)...);
+            }, std::forward<Func>(func), std::forward<Args>(args)...);
+    }
+
+    template<typename Self, typename Type>
+    constexpr auto&& _Forward_like(Type& value) noexcept {
+        constexpr bool is_const = std::is_const_v<std::remove_reference_t<Self>>;
+        if constexpr (std::is_lvalue_reference_v<Self>) {
+            if constexpr (is_const) {
+                return std::as_const(value);
+            }
+            else {
+                return value;
+            }
+        }
+        else {
+            if constexpr (is_const) {
+                return std::move(std::as_const(value));
+            }
+            else {
+                return std::move(value);
+            }
+        }
+    }
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <cstddef>
+#include <type_traits>
+
+// Where a Variant keeps the index of its active alternative: in a separate
+// member after the storage (tagged), inside the storage in its tail padding
+// or in front of the alternatives (packed), or in spare bit patterns of one
+// alternative (niche, see meta_functions::niche_traits).
+enum class VariantLayoutKind : unsigned char {
+    tagged,
+    packed,
+    niche
+};
+
+// Compile-time description of a Variant instantiation, see variant_layout_v.
+// index_offset and index_size give the bytes holding the index; for the
+// niche layout, the niche field of the alternative that carries it.
+struct VariantLayout {
+    VariantLayoutKind kind;
+    std::size_t size;
+    std::size_t alignment;
+    std::size_t index_offset;
+    std::size_t index_size;
+};
+
+namespace meta_functions {
+    // Variants of exactly Types may keep the index in spare bit patterns of an
+    // alternative (the niche layout) or inside the storage bytes (the packed
+    // layout) when this is specialized as std::true_type. Both layouts read
+    // and write the storage as bytes, so such Variants cannot be used in
+    // constant expressions; by default the index stays in a member of its own.
+    template<typename... Types>
+    struct enable_compact_layout : std::false_type {};
+
+    template<typename... Types>
+    inline constexpr bool enable_compact_layout_v = enable_compact_layout<Types...>::value;
+}
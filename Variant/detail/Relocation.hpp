@@ -0,0 +1,57 @@
+#pragma once
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include "../../Auxiliary_meta_functions/Auxiliary_meta_functions/Auxiliary_meta_functions.hpp"
+
+namespace meta_functions {
+    // Owns nothing but a pointer, on every standard library we build with.
+    template<typename Type>
+    struct is_trivially_relocatable<std::unique_ptr<Type>> : std::true_type {};
+}
+
+// Moves *source into the uninitialized storage at target and ends the lifetime
+// of *source: its destructor must not run afterwards. Trivially relocatable
+// types are copied bytewise; others are move-constructed and destroyed.
+template<typename Type>
+    requires std::is_move_constructible_v<Type> && std::is_destructible_v<Type>
+Type* relocate(Type* source, Type* target)
+    noexcept(meta_functions::is_trivially_relocatable_v<Type> ||
+             std::is_nothrow_move_constructible_v<Type>)
+{
+    if constexpr (meta_functions::is_trivially_relocatable_v<Type>) {
+        std::memcpy(static_cast<void*>(target), static_cast<const void*>(source), sizeof(Type));
+        return std::launder(target);
+    }
+    else {
+        Type* result = std::construct_at(target, std::move(*source));
+        std::destroy_at(source);
+        return result;
+    }
+}
+
+// Relocates [first, last) into the uninitialized storage starting at target,
+// which must not overlap the source range, and returns the end of the new
+// range. If a move constructor throws, the objects already built at target are
+// destroyed and the whole source range is left alive.
+template<typename Type>
+    requires std::is_move_constructible_v<Type> && std::is_destructible_v<Type>
+Type* relocate_range(Type* first, Type* last, Type* target)
+    noexcept(meta_functions::is_trivially_relocatable_v<Type> ||
+             std::is_nothrow_move_constructible_v<Type>)
+{
+    const std::size_t count = static_cast<std::size_t>(last - first);
+    if constexpr (meta_functions::is_trivially_relocatable_v<Type>) {
+        if (count != 0) {
+            std::memcpy(static_cast<void*>(target), static_cast<const void*>(first), count * sizeof(Type));
+        }
+        return std::launder(target) + count;
+    }
+    else {
+        Type* result = std::uninitialized_move(first, last, target);
+        std::destroy(first, last);
+        return result;
+    }
+}
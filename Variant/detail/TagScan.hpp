@@ -0,0 +1,275 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+// Kernels that scan a column of one-byte alternative indices (tags), as kept
+// by VariantArray. Counting, searching and histogramming come in a scalar,
+// an SSE2 and an AVX2 version; the dispatching functions pick the widest one
+// the processor supports at run time, so the library itself needs no
+// instruction set flags.
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define VARIANT_X86_SIMD
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define VARIANT_TARGET(isa)
+#else
+#define VARIANT_TARGET(isa) __attribute__((target(isa)))
+#endif
+#endif
+
+namespace variant_detail {
+    enum class _Simd_level : unsigned char {
+        scalar,
+        sse2,
+        avx2
+    };
+
+    inline _Simd_level _Detect_simd_level() noexcept {
+#if defined(VARIANT_X86_SIMD) && defined(_MSC_VER) && !defined(__clang__)
+        int info[4];
+        __cpuid(info, 0);
+        const int max_leaf = info[0];
+        __cpuid(info, 1);
+        const bool sse2 = (info[3] & (1 << 26)) != 0;
+        const bool os_saves_ymm = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 6) == 6;
+        bool avx2 = false;
+        if (max_leaf >= 7 && os_saves_ymm) {
+            __cpuidex(info, 7, 0);
+            avx2 = (info[1] & (1 << 5)) != 0;
+        }
+        return avx2 ? _Simd_level::avx2 : sse2 ? _Simd_level::sse2 : _Simd_level::scalar;
+#elif defined(VARIANT_X86_SIMD)
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") ? _Simd_level::avx2 :
+            __builtin_cpu_supports("sse2") ? _Simd_level::sse2 : _Simd_level::scalar;
+#else
+        return _Simd_level::scalar;
+#endif
+    }
+
+    // Detected once per process.
+    inline _Simd_level _Supported_simd_level() noexcept {
+        static const _Simd_level level = _Detect_simd_level();
+        return level;
+    }
+
+    // Packs with more alternatives than this are histogrammed by the scalar
+    // kernel, which needs no register per tag.
+    inline constexpr std::size_t _Simd_tag_limit = 16;
+
+    inline std::size_t _Count_tag_scalar(const std::uint8_t* tags, std::size_t size, std::uint8_t tag) noexcept {
+        std::size_t total = 0;
+        for (std::size_t position = 0; position < size; ++position) {
+            total += tags[position] == tag;
+        }
+        return total;
+    }
+
+    inline std::size_t _Find_tag_scalar(const std::uint8_t* tags, std::size_t size,
+        std::size_t from, std::uint8_t tag) noexcept {
+        while (from < size && tags[from] != tag) {
+            ++from;
+        }
+        return from;
+    }
+
+    inline void _Tag_histogram_scalar(const std::uint8_t* tags, std::size_t size, std::size_t* counts) noexcept {
+        for (std::size_t position = 0; position < size; ++position) {
+            ++counts[tags[position]];
+        }
+    }
+
+    // Writes the position of every tag with index tag to cursors[tag],
+    // advancing it; each cursor must have room for all of them. Scalar only:
+    // extracting positions from compare masks branches on every match and
+    // loses to this store loop unless one tag dominates.
+    inline void _Tag_positions(const std::uint8_t* tags, std::size_t size, std::size_t** cursors) noexcept {
+        for (std::size_t position = 0; position < size; ++position) {
+            *cursors[tags[position]]++ = position;
+        }
+    }
+
+#ifdef VARIANT_X86_SIMD
+    // Byte counters fed by subtracting compare masks overflow after 255
+    // blocks; the kernels fold them into totals before that.
+    inline constexpr std::size_t _Blocks_per_fold = 255;
+
+    VARIANT_TARGET("sse2")
+    inline std::size_t _Sum_bytes_sse2(__m128i bytes) noexcept {
+        const __m128i sums = _mm_sad_epu8(bytes, _mm_setzero_si128());
+        return static_cast<std::size_t>(_mm_cvtsi128_si32(sums)) +
+            static_cast<std::size_t>(_mm_cvtsi128_si32(_mm_srli_si128(sums, 8)));
+    }
+
+    VARIANT_TARGET("sse2")
+    inline std::size_t _Count_tag_sse2(const std::uint8_t* tags, std::size_t size, std::uint8_t tag) noexcept {
+        const __m128i needle = _mm_set1_epi8(static_cast<char>(tag));
+        std::size_t total = 0;
+        std::size_t position = 0;
+        while (size - position >= 16) {
+            const std::size_t blocks = std::min((size - position) / 16, _Blocks_per_fold);
+            __m128i counters = _mm_setzero_si128();
+            for (std::size_t block = 0; block < blocks; ++block, position += 16) {
+                const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tags + position));
+                counters = _mm_sub_epi8(counters, _mm_cmpeq_epi8(chunk, needle));
+            }
+            total += _Sum_bytes_sse2(counters);
+        }
+        return total + _Count_tag_scalar(tags + position, size - position, tag);
+    }
+
+    VARIANT_TARGET("sse2")
+    inline std::size_t _Find_tag_sse2(const std::uint8_t* tags, std::size_t size,
+        std::size_t from, std::uint8_t tag) noexcept {
+        const __m128i needle = _mm_set1_epi8(static_cast<char>(tag));
+        for (; size - from >= 16; from += 16) {
+            const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tags + from));
+            const auto mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle)));
+            if (mask != 0) {
+                return from + static_cast<std::size_t>(std::countr_zero(mask));
+            }
+        }
+        return _Find_tag_scalar(tags, size, from, tag);
+    }
+
+    template<std::size_t N>
+    VARIANT_TARGET("sse2")
+    inline void _Tag_histogram_sse2(const std::uint8_t* tags, std::size_t size, std::size_t* counts) noexcept {
+        std::size_t position = 0;
+        while (size - position >= 16) {
+            const std::size_t blocks = std::min((size - position) / 16, _Blocks_per_fold);
+            __m128i counters[N];
+            for (std::size_t tag = 0; tag < N; ++tag) {
+                counters[tag] = _mm_setzero_si128();
+            }
+            for (std::size_t block = 0; block < blocks; ++block, position += 16) {
+                const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tags + position));
+                for (std::size_t tag = 0; tag < N; ++tag) {
+                    counters[tag] = _mm_sub_epi8(counters[tag],
+                        _mm_cmpeq_epi8(chunk, _mm_set1_epi8(static_cast<char>(tag))));
+                }
+            }
+            for (std::size_t tag = 0; tag < N; ++tag) {
+                counts[tag] += _Sum_bytes_sse2(counters[tag]);
+            }
+        }
+        _Tag_histogram_scalar(tags + position, size - position, counts);
+    }
+
+    VARIANT_TARGET("avx2")
+    inline std::size_t _Sum_bytes_avx2(__m256i bytes) noexcept {
+        const __m256i sums = _mm256_sad_epu8(bytes, _mm256_setzero_si256());
+        const __m128i halves = _mm_add_epi64(_mm256_castsi256_si128(sums), _mm256_extracti128_si256(sums, 1));
+        return static_cast<std::size_t>(_mm_cvtsi128_si32(halves)) +
+            static_cast<std::size_t>(_mm_cvtsi128_si32(_mm_srli_si128(halves, 8)));
+    }
+
+    VARIANT_TARGET("avx2")
+    inline std::size_t _Count_tag_avx2(const std::uint8_t* tags, std::size_t size, std::uint8_t tag) noexcept {
+        const __m256i needle = _mm256_set1_epi8(static_cast<char>(tag));
+        std::size_t total = 0;
+        std::size_t position = 0;
+        while (size - position >= 32) {
+            const std::size_t blocks = std::min((size - position) / 32, _Blocks_per_fold);
+            __m256i counters = _mm256_setzero_si256();
+            for (std::size_t block = 0; block < blocks; ++block, position += 32) {
+                const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(tags + position));
+                counters = _mm256_sub_epi8(counters, _mm256_cmpeq_epi8(chunk, needle));
+            }
+            total += _Sum_bytes_avx2(counters);
+        }
+        return total + _Count_tag_sse2(tags + position, size - position, tag);
+    }
+
+    VARIANT_TARGET("avx2")
+    inline std::size_t _Find_tag_avx2(const std::uint8_t* tags, std::size_t size,
+        std::size_t from, std::uint8_t tag) noexcept {
+        const __m256i needle = _mm256_set1_epi8(static_cast<char>(tag));
+        for (; size - from >= 32; from += 32) {
+            const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(tags + from));
+            const auto mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, needle)));
+            if (mask != 0) {
+                return from + static_cast<std::size_t>(std::countr_zero(mask));
+            }
+        }
+        return _Find_tag_sse2(tags, size, from, tag);
+    }
+
+    template<std::size_t N>
+    VARIANT_TARGET("avx2")
+    inline void _Tag_histogram_avx2(const std::uint8_t* tags, std::size_t size, std::size_t* counts) noexcept {
+        std::size_t position = 0;
+        while (size - position >= 32) {
+            const std::size_t blocks = std::min((size - position) / 32, _Blocks_per_fold);
+            __m256i counters[N];
+            for (std::size_t tag = 0; tag < N; ++tag) {
+                counters[tag] = _mm256_setzero_si256();
+            }
+            for (std::size_t block = 0; block < blocks; ++block, position += 32) {
+                const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(tags + position));
+                for (std::size_t tag = 0; tag < N; ++tag) {
+                    counters[tag] = _mm256_sub_epi8(counters[tag],
+                        _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(static_cast<char>(tag))));
+                }
+            }
+            for (std::size_t tag = 0; tag < N; ++tag) {
+                counts[tag] += _Sum_bytes_avx2(counters[tag]);
+            }
+        }
+        _Tag_histogram_scalar(tags + position, size - position, counts);
+    }
+
+#endif
+
+    // Number of tags equal to tag.
+    inline std::size_t _Count_tag(const std::uint8_t* tags, std::size_t size, std::uint8_t tag) noexcept {
+#ifdef VARIANT_X86_SIMD
+        switch (_Supported_simd_level()) {
+        case _Simd_level::avx2:
+            return _Count_tag_avx2(tags, size, tag);
+        case _Simd_level::sse2:
+            return _Count_tag_sse2(tags, size, tag);
+        default:
+            break;
+        }
+#endif
+        return _Count_tag_scalar(tags, size, tag);
+    }
+
+    // Position of the first tag equal to tag at or after from, or size.
+    inline std::size_t _Find_tag(const std::uint8_t* tags, std::size_t size,
+        std::size_t from, std::uint8_t tag) noexcept {
+#ifdef VARIANT_X86_SIMD
+        switch (_Supported_simd_level()) {
+        case _Simd_level::avx2:
+            return _Find_tag_avx2(tags, size, from, tag);
+        case _Simd_level::sse2:
+            return _Find_tag_sse2(tags, size, from, tag);
+        default:
+            break;
+        }
+#endif
+        return _Find_tag_scalar(tags, size, from, tag);
+    }
+
+    // Adds the number of tags equal to each of 0..N-1 to counts[0..N-1].
+    template<std::size_t N>
+    void _Tag_histogram(const std::uint8_t* tags, std::size_t size, std::size_t* counts) noexcept {
+#ifdef VARIANT_X86_SIMD
+        if constexpr (N <= _Simd_tag_limit) {
+            switch (_Supported_simd_level()) {
+            case _Simd_level::avx2:
+                return _Tag_histogram_avx2<N>(tags, size, counts);
+            case _Simd_level::sse2:
+                return _Tag_histogram_sse2<N>(tags, size, counts);
+            default:
+                break;
+            }
+        }
+#endif
+        _Tag_histogram_scalar(tags, size, counts);
+    }
+}
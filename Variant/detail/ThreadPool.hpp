@@ -0,0 +1,231 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Access.hpp"
+
+namespace variant_detail {
+    // The chunks of a job still to be run by one participant, as the range
+    // [begin, end). The owner takes chunks from the front; a participant that
+    // ran out steals the back half, so chunks that turn out cheaper on one
+    // thread than on another leave no thread idle while work remains. No
+    // thread ever holds two of these locks at once.
+    struct alignas(64) _Chunk_range {
+        std::mutex mutex;
+        std::size_t begin = 0;
+        std::size_t end = 0;
+
+        void assign(std::size_t first, std::size_t last) {
+            std::lock_guard lock(mutex);
+            begin = first;
+            end = last;
+        }
+
+        bool pop_front(std::size_t& chunk) {
+            std::lock_guard lock(mutex);
+            if (begin == end) {
+                return false;
+            }
+            chunk = begin++;
+            return true;
+        }
+
+        // Moves the back half of victim's chunks, rounded up, here.
+        bool steal_from(_Chunk_range& victim) {
+            std::size_t first;
+            std::size_t last;
+            {
+                std::lock_guard lock(victim.mutex);
+                const std::size_t left = victim.end - victim.begin;
+                if (left == 0) {
+                    return false;
+                }
+                last = victim.end;
+                first = last - (left + 1) / 2;
+                victim.end = first;
+            }
+            assign(first, last);
+            return true;
+        }
+    };
+
+    // Fixed set of worker threads that run a body over numbered chunks
+    // together with the calling thread. Each participant starts with an equal
+    // share of the chunks and steals from the others once its own are done.
+    // One job runs at a time; a job started from inside a body of the same
+    // pool runs on the calling thread alone instead of waiting for itself.
+    class _Thread_pool {
+    public:
+        // threads counts the calling thread, so a pool of one starts no
+        // worker and runs every job serially.
+        explicit _Thread_pool(std::size_t threads = std::thread::hardware_concurrency())
+            : _ranges(std::max<std::size_t>(threads, 1)) {
+            _workers.reserve(_ranges.size() - 1);
+            for (std::size_t participant = 1; participant < _ranges.size(); ++participant) {
+                _workers.emplace_back([this, participant] { _work(participant); });
+            }
+        }
+
+        _Thread_pool(const _Thread_pool&) = delete;
+        _Thread_pool& operator=(const _Thread_pool&) = delete;
+
+        ~_Thread_pool() {
+            {
+                std::lock_guard lock(_mutex);
+                _stopping = true;
+            }
+            _wake.notify_all();
+            for (std::thread& worker : _workers) {
+                worker.join();
+            }
+        }
+
+        std::size_t size() const noexcept {
+            return _ranges.size();
+        }
+
+        // One worker per hardware thread, started on first use.
+        static _Thread_pool& shared() {
+            static _Thread_pool pool;
+            return pool;
+        }
+
+        // Calls body(chunk) for every chunk in [0, chunks) and returns once
+        // all calls have. If one throws, chunks not yet started are skipped
+        // and the first exception is rethrown here.
+        template<typename Body>
+        void run(std::size_t chunks, Body& body) {
+            if (size() == 1 || chunks <= 1 || _current_pool() == this) {
+                for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+                    body(chunk);
+                }
+                return;
+            }
+
+            std::lock_guard run_lock(_run_mutex);
+            _Job job(&body, [](void* context, std::size_t chunk) { (*static_cast<Body*>(context))(chunk); });
+            const std::size_t participants = std::min(size(), chunks);
+            for (std::size_t participant = 0; participant < size(); ++participant) {
+                if (participant < participants) {
+                    _ranges[participant].assign(chunks * participant / participants,
+                        chunks * (participant + 1) / participants);
+                }
+                else {
+                    _ranges[participant].assign(0, 0);
+                }
+            }
+            {
+                std::lock_guard lock(_mutex);
+                _job = &job;
+                _busy = _workers.size();
+                ++_generation;
+            }
+            _wake.notify_all();
+            _participate(0, job);
+            {
+                std::unique_lock lock(_mutex);
+                _done.wait(lock, [this] { return _busy == 0; });
+                _job = nullptr;
+            }
+#ifndef VARIANT_NO_EXCEPTIONS
+            if (job.error) {
+                std::rethrow_exception(job.error);
+            }
+#endif
+        }
+
+    private:
+        struct _Job {
+            _Job(void* job_body, void (*job_call)(void*, std::size_t)) noexcept
+                : body(job_body), call(job_call) {}
+
+            void* body;
+            void (*call)(void*, std::size_t);
+            std::atomic<bool> failed{ false };
+            std::mutex error_mutex;
+            std::exception_ptr error;
+        };
+
+        static const _Thread_pool*& _current_pool() noexcept {
+            thread_local const _Thread_pool* pool = nullptr;
+            return pool;
+        }
+
+        void _participate(std::size_t participant, _Job& job) {
+            const _Thread_pool* const outer = _current_pool();
+            _current_pool() = this;
+            std::size_t chunk;
+            while (!job.failed.load(std::memory_order_relaxed)) {
+                if (!_ranges[participant].pop_front(chunk)) {
+                    if (_steal(participant)) {
+                        continue;
+                    }
+                    break;
+                }
+#ifdef VARIANT_NO_EXCEPTIONS
+                job.call(job.body, chunk);
+#else
+                try {
+                    job.call(job.body, chunk);
+                }
+                catch (...) {
+                    std::lock_guard lock(job.error_mutex);
+                    if (!job.error) {
+                        job.error = std::current_exception();
+                    }
+                    job.failed.store(true, std::memory_order_relaxed);
+                }
+#endif
+            }
+            _current_pool() = outer;
+        }
+
+        bool _steal(std::size_t thief) {
+            for (std::size_t offset = 1; offset < size(); ++offset) {
+                if (_ranges[thief].steal_from(_ranges[(thief + offset) % size()])) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void _work(std::size_t participant) {
+            std::size_t seen = 0;
+            for (;;) {
+                _Job* job;
+                {
+                    std::unique_lock lock(_mutex);
+                    _wake.wait(lock, [this, seen] { return _stopping || _generation != seen; });
+                    if (_stopping) {
+                        return;
+                    }
+                    seen = _generation;
+                    job = _job;
+                }
+                _participate(participant, *job);
+                {
+                    std::lock_guard lock(_mutex);
+                    if (--_busy == 0) {
+                        _done.notify_one();
+                    }
+                }
+            }
+        }
+
+        std::vector<_Chunk_range> _ranges;
+        std::vector<std::thread> _workers;
+        std::mutex _run_mutex;
+        std::mutex _mutex;
+        std::condition_variable _wake;
+        std::condition_variable _done;
+        _Job* _job = nullptr;
+        std::size_t _busy = 0;
+        std::size_t _generation = 0;
+        bool _stopping = false;
+    };
+}
@@ -0,0 +1,40 @@
+#include "Benchmark.hpp"
+#include "Payloads.hpp"
+
+#include <string>
+
+namespace {
+    constexpr std::size_t elements = 1024;
+
+    // The loop already tests the index through holds_alternative, the pattern
+    // in which the check inside get is redundant.
+    template<std::size_t N, VariantAccessPolicy Policy>
+    void get_after_holds_alternative(bench::State& state) {
+        using Last = bench::Payload<N - 1>;
+        auto variants = bench::random_variants<bench::PayloadVariant<N>, N>(elements);
+        int sum = 0;
+        for (std::size_t i : state) {
+            const auto& variant = variants[i % elements];
+            if (variant.template holds_alternative<Last>()) {
+                sum += variant.template get<Last, Policy>().value;
+            }
+        }
+        bench::do_not_optimize(sum);
+    }
+
+    template<std::size_t N>
+    struct AccessPolicyCases {
+        AccessPolicyCases() {
+            const std::string prefix = "GetAfterHoldsAlternative/" + std::to_string(N);
+            bench::Registrar(prefix + "/checked",
+                get_after_holds_alternative<N, VariantAccessPolicy::checked>);
+            bench::Registrar(prefix + "/asserting",
+                get_after_holds_alternative<N, VariantAccessPolicy::asserting>);
+            bench::Registrar(prefix + "/unchecked",
+                get_after_holds_alternative<N, VariantAccessPolicy::unchecked>);
+        }
+    };
+
+    const AccessPolicyCases<2> cases2;
+    const AccessPolicyCases<8> cases8;
+}
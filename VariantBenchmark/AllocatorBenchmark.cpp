@@ -0,0 +1,76 @@
+#include "Benchmark.hpp"
+
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "Variant.hpp"
+
+namespace {
+    using Field = Variant<std::pmr::string, std::pmr::vector<int>, int>;
+    using StdField = std::variant<std::pmr::string, std::pmr::vector<int>, int>;
+
+    constexpr const char* text = "a field long enough to leave the small string buffer";
+
+    template<typename Document>
+    void fill(Document& document, std::size_t count) {
+        for (std::size_t at = 0; at < count; ++at) {
+            switch (at % 3) {
+            case 0:
+                document.emplace_back(std::in_place_index<0>, text);
+                break;
+            case 1:
+                document.emplace_back(std::in_place_index<1>, 8, static_cast<int>(at));
+                break;
+            default:
+                document.emplace_back(std::in_place_index<2>, static_cast<int>(at));
+                break;
+            }
+        }
+    }
+
+    // Builds a document of Count fields in an arena that is released as a
+    // whole afterwards. The Variant fields take the arena from the vector
+    // through uses-allocator construction; the std::variant ones cannot, so
+    // their strings and vectors still come from the default resource.
+    template<typename Element, std::size_t Count>
+    void build_in_arena(bench::State& state) {
+        std::vector<std::byte> buffer(Count * 256);
+        std::size_t size = 0;
+        for (std::size_t i : state) {
+            (void)i;
+            std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+            std::pmr::vector<Element> document(&arena);
+            fill(document, Count);
+            size += document.size();
+        }
+        bench::do_not_optimize(size);
+    }
+
+    template<std::size_t Count>
+    void build_on_heap(bench::State& state) {
+        std::size_t size = 0;
+        for (std::size_t i : state) {
+            (void)i;
+            std::pmr::vector<Field> document(std::pmr::new_delete_resource());
+            fill(document, Count);
+            size += document.size();
+        }
+        bench::do_not_optimize(size);
+    }
+
+    template<std::size_t Count>
+    struct AllocatorCases {
+        AllocatorCases() {
+            const std::string prefix = "ArenaDocument/" + std::to_string(Count);
+            bench::Registrar(prefix + "/Variant", build_in_arena<Field, Count>);
+            bench::Registrar(prefix + "/std::variant", build_in_arena<StdField, Count>);
+            bench::Registrar(prefix + "/Variant_on_heap", build_on_heap<Count>);
+        }
+    };
+
+    const AllocatorCases<1024> cases1k;
+    const AllocatorCases<(1 << 16)> cases64k;
+}
@@ -0,0 +1,88 @@
+#include "Benchmark.hpp"
+
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "Variant.hpp"
+
+namespace {
+    constexpr std::size_t elements = 64;
+
+    template<template<typename...> class VariantTemplate>
+    using Container = VariantTemplate<std::string, std::vector<int>>;
+
+    // Values that differ only in their last element are the worst case for an
+    // assignment that compares the operands first. The benchmarks alternate
+    // between two sources so the target never already equals the source.
+    template<template<typename...> class VariantTemplate>
+    std::vector<Container<VariantTemplate>> make_strings(char last) {
+        std::string value(256, 'x');
+        value.back() = last;
+        return std::vector<Container<VariantTemplate>>(elements, Container<VariantTemplate>(value));
+    }
+
+    template<template<typename...> class VariantTemplate>
+    std::vector<Container<VariantTemplate>> make_vectors(int last) {
+        std::vector<int> value(64, 7);
+        value.back() = last;
+        return std::vector<Container<VariantTemplate>>(elements, Container<VariantTemplate>(value));
+    }
+
+    template<template<typename...> class VariantTemplate>
+    std::vector<Container<VariantTemplate>> make_mixed() {
+        std::vector<Container<VariantTemplate>> result;
+        for (std::size_t i = 0; i < elements; ++i) {
+            if (i % 2 == 0) {
+                result.emplace_back(std::string(256, 'x'));
+            }
+            else {
+                result.emplace_back(std::vector<int>(64, 7));
+            }
+        }
+        return result;
+    }
+
+    template<template<typename...> class VariantTemplate>
+    void assign_same_string(bench::State& state) {
+        auto target = make_strings<VariantTemplate>('a');
+        const auto first = make_strings<VariantTemplate>('b');
+        const auto second = make_strings<VariantTemplate>('c');
+        for (std::size_t i : state) {
+            const std::size_t at = i % elements;
+            target[at] = (i / elements) % 2 == 0 ? first[at] : second[at];
+            bench::do_not_optimize(target[at]);
+        }
+    }
+
+    template<template<typename...> class VariantTemplate>
+    void assign_same_vector(bench::State& state) {
+        auto target = make_vectors<VariantTemplate>(1);
+        const auto first = make_vectors<VariantTemplate>(2);
+        const auto second = make_vectors<VariantTemplate>(3);
+        for (std::size_t i : state) {
+            const std::size_t at = i % elements;
+            target[at] = (i / elements) % 2 == 0 ? first[at] : second[at];
+            bench::do_not_optimize(target[at]);
+        }
+    }
+
+    // Every assignment switches the alternative.
+    template<template<typename...> class VariantTemplate>
+    void assign_alternating(bench::State& state) {
+        auto target = make_mixed<VariantTemplate>();
+        const auto source = make_mixed<VariantTemplate>();
+        for (std::size_t i : state) {
+            const std::size_t at = i % elements;
+            target[at] = source[(at + 1 + i / elements) % elements];
+            bench::do_not_optimize(target[at]);
+        }
+    }
+
+    const bench::Registrar same_string("Assign/copy/same/string/Variant", assign_same_string<Variant>);
+    const bench::Registrar same_string_std("Assign/copy/same/string/std::variant", assign_same_string<std::variant>);
+    const bench::Registrar same_vector("Assign/copy/same/vector/Variant", assign_same_vector<Variant>);
+    const bench::Registrar same_vector_std("Assign/copy/same/vector/std::variant", assign_same_vector<std::variant>);
+    const bench::Registrar alternating("Assign/copy/alternating/Variant", assign_alternating<Variant>);
+    const bench::Registrar alternating_std("Assign/copy/alternating/std::variant", assign_alternating<std::variant>);
+}
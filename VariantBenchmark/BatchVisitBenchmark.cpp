@@ -0,0 +1,83 @@
+#include "Benchmark.hpp"
+
+#include <cstddef>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "Payloads.hpp"
+#include "VariantAlgorithms.hpp"
+
+namespace {
+    constexpr std::size_t count = 1 << 20;
+
+    // Work that differs by alternative in more than a constant, so the
+    // compiler cannot turn the dispatch into a table lookup.
+    struct Mix {
+        unsigned total = 0;
+
+        template<std::size_t I>
+        void operator()(const bench::Payload<I>& payload) noexcept {
+            for (std::size_t step = 0; step < I % 4 + 1; ++step) {
+                total = total * 31 + static_cast<unsigned>(payload.value);
+            }
+        }
+    };
+
+    template<std::size_t N>
+    void batch_visit(bench::State& state) {
+        const auto values = bench::random_variants<bench::PayloadVariant<N>, N>(count);
+        unsigned total = 0;
+        for (std::size_t i : state) {
+            (void)i;
+            Mix mix;
+            visit_batch(values, mix);
+            total += mix.total;
+        }
+        bench::do_not_optimize(total);
+    }
+
+    template<std::size_t N>
+    void element_visit(bench::State& state) {
+        const auto values = bench::random_variants<bench::PayloadVariant<N>, N>(count);
+        unsigned total = 0;
+        for (std::size_t i : state) {
+            (void)i;
+            Mix mix;
+            for (const auto& value : values) {
+                value.visit(mix);
+            }
+            total += mix.total;
+        }
+        bench::do_not_optimize(total);
+    }
+
+    template<std::size_t N>
+    void std_visit(bench::State& state) {
+        const auto values = bench::random_variants<bench::StdPayloadVariant<N>, N>(count);
+        unsigned total = 0;
+        for (std::size_t i : state) {
+            (void)i;
+            Mix mix;
+            for (const auto& value : values) {
+                std::visit(mix, value);
+            }
+            total += mix.total;
+        }
+        bench::do_not_optimize(total);
+    }
+
+    template<std::size_t N>
+    struct BatchVisitCases {
+        BatchVisitCases() {
+            const std::string size = std::to_string(N);
+            bench::Registrar("BatchVisit/" + size + "/visit_batch", batch_visit<N>);
+            bench::Registrar("BatchVisit/" + size + "/Variant", element_visit<N>);
+            bench::Registrar("BatchVisit/" + size + "/std::variant", std_visit<N>);
+        }
+    };
+
+    const BatchVisitCases<4> cases4;
+    const BatchVisitCases<16> cases16;
+    const BatchVisitCases<64> cases64;
+}
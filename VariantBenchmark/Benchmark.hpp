@@ -0,0 +1,180 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace bench {
+    // Forces value to memory rather than into a register: reading back a
+    // freshly stored small variant through a register stalls on store
+    // forwarding and swamps the cost being measured.
+    template<typename Type>
+    inline void do_not_optimize(Type&& value) {
+#if defined(_MSC_VER) && !defined(__clang__)
+        static const volatile void* sink;
+        sink = std::addressof(value);
+        _ReadWriteBarrier();
+#else
+        asm volatile("" : : "m"(value) : "memory");
+#endif
+    }
+
+    inline void clobber_memory() {
+#if defined(_MSC_VER) && !defined(__clang__)
+        _ReadWriteBarrier();
+#else
+        asm volatile("" : : : "memory");
+#endif
+    }
+
+    using clock = std::chrono::steady_clock;
+
+    // Iterating over the state runs the timed loop; code before the loop is
+    // setup and is not measured.
+    class State {
+    public:
+        explicit State(std::size_t iterations) : _iterations(iterations) {}
+
+        class Iterator {
+        public:
+            Iterator(State* state, std::size_t position) : _state(state), _position(position) {}
+
+            std::size_t operator*() const { return _position; }
+
+            Iterator& operator++() {
+                ++_position;
+                return *this;
+            }
+
+            bool operator!=(const Iterator& other) {
+                if (_position != other._position) {
+                    return true;
+                }
+                _state->_stop();
+                return false;
+            }
+
+        private:
+            State* _state;
+            std::size_t _position;
+        };
+
+        Iterator begin() {
+            _start = clock::now();
+            return Iterator(this, 0);
+        }
+
+        Iterator end() {
+            return Iterator(this, _iterations);
+        }
+
+        std::size_t iterations() const { return _iterations; }
+
+        // Excludes per-batch setup done inside the timed loop.
+        void pause_timing() { _stop(); }
+
+        void resume_timing() { _start = clock::now(); }
+
+        clock::duration elapsed() const { return _elapsed; }
+
+    private:
+        void _stop() { _elapsed += clock::now() - _start; }
+
+        std::size_t _iterations;
+        clock::time_point _start{};
+        clock::duration _elapsed{};
+    };
+
+    using Body = std::function<void(State&)>;
+
+    struct Case {
+        std::string name;
+        Body body;
+        // Bytes one iteration reads, to report throughput; 0 if not given.
+        std::size_t bytes = 0;
+    };
+
+    inline std::vector<Case>& registry() {
+        static std::vector<Case> cases;
+        return cases;
+    }
+
+    struct Registrar {
+        Registrar(std::string name, Body body, std::size_t bytes = 0) {
+            registry().push_back({ std::move(name), std::move(body), bytes });
+        }
+    };
+
+    // Doubles the iteration count until the timed loop takes at least
+    // min_time and reports the average time of one iteration in nanoseconds.
+    inline double measure(const Body& body,
+        std::chrono::nanoseconds min_time = std::chrono::milliseconds(200)) {
+        std::size_t iterations = 1;
+        while (true) {
+            State state(iterations);
+            body(state);
+            if (state.elapsed() >= min_time || iterations >= (std::size_t(1) << 34)) {
+                return std::chrono::duration<double, std::nano>(state.elapsed()).count() / iterations;
+            }
+            iterations *= 2;
+        }
+    }
+
+    inline const Case* find_case(std::string_view name) {
+        for (const Case& benchmark : registry()) {
+            if (benchmark.name == name) {
+                return &benchmark;
+            }
+        }
+        return nullptr;
+    }
+
+    inline constexpr std::string_view variant_suffix = "/Variant";
+    inline constexpr std::string_view std_variant_suffix = "/std::variant";
+
+    // Cases registered as "<name>/Variant" and "<name>/std::variant" are
+    // measured together and reported on one row with their ratio.
+    inline int run_all(std::string_view filter) {
+        std::printf("%-56s %14s %14s %8s\n", "Benchmark", "Variant ns", "std ns", "ratio");
+        for (const Case& benchmark : registry()) {
+            if (!filter.empty() && benchmark.name.find(filter) == std::string::npos) {
+                continue;
+            }
+            const std::string_view name = benchmark.name;
+            if (name.ends_with(std_variant_suffix) &&
+                find_case(std::string(name.substr(0, name.size() - std_variant_suffix.size())) +
+                    std::string(variant_suffix))) {
+                continue;
+            }
+            if (name.ends_with(variant_suffix)) {
+                const std::string base(name.substr(0, name.size() - variant_suffix.size()));
+                if (const Case* reference = find_case(base + std::string(std_variant_suffix))) {
+                    const double ours = measure(benchmark.body);
+                    const double theirs = measure(reference->body);
+                    std::printf("%-56s %14.3f %14.3f %8.2f\n", base.c_str(), ours, theirs, ours / theirs);
+                    std::fflush(stdout);
+                    continue;
+                }
+            }
+            const double ns = measure(benchmark.body);
+            if (benchmark.bytes != 0) {
+                std::printf("%-56s %14.3f %24.2f GB/s\n", benchmark.name.c_str(), ns, benchmark.bytes / ns);
+            }
+            else {
+                std::printf("%-56s %14.3f\n", benchmark.name.c_str(), ns);
+            }
+            std::fflush(stdout);
+        }
+        return 0;
+    }
+}
@@ -0,0 +1,95 @@
+#include "Benchmark.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "Variant.hpp"
+
+namespace {
+    struct Tick {
+        std::uint32_t id;
+        std::uint32_t price;
+    };
+
+    // The rare message that sets the size of every queue element when kept
+    // inline.
+    struct Snapshot {
+        std::array<std::uint64_t, 64> levels;
+    };
+
+    using BoxedMessage = Variant<Tick, Boxed<Snapshot>>;
+    using InlineMessage = Variant<Tick, Snapshot>;
+    using StdMessage = std::variant<Tick, Snapshot>;
+
+    static_assert(sizeof(BoxedMessage) == 16);
+    static_assert(sizeof(InlineMessage) == 520);
+
+    std::uint64_t value_of(const Tick& tick) {
+        return tick.price;
+    }
+
+    std::uint64_t value_of(const Snapshot& snapshot) {
+        return snapshot.levels[0] + snapshot.levels[63];
+    }
+
+    template<typename Message>
+    std::uint64_t consume(const Message& message) {
+        return message.visit([](const auto& alternative) { return value_of(alternative); });
+    }
+
+    std::uint64_t consume(const StdMessage& message) {
+        return std::visit([](const auto& alternative) { return value_of(alternative); }, message);
+    }
+
+    // Fills a queue of Count messages, one in a hundred a Snapshot, then
+    // drains it. The queue of boxed messages takes 16 bytes a message plus
+    // 512 per Snapshot, the inline one 520 bytes a message.
+    template<typename Message, std::size_t Count>
+    void fill_and_drain(bench::State& state) {
+        std::mt19937 engine(42);
+        std::vector<std::uint32_t> kinds(Count);
+        for (auto& kind : kinds) {
+            kind = static_cast<std::uint32_t>(engine() % 100);
+        }
+
+        std::vector<Message> queue;
+        queue.reserve(Count);
+        Snapshot snapshot{};
+        std::uint64_t sum = 0;
+        for (std::size_t i : state) {
+            (void)i;
+            for (std::size_t at = 0; at < Count; ++at) {
+                if (kinds[at] == 0) {
+                    snapshot.levels[0] = at;
+                    queue.emplace_back(std::in_place_index<1>, snapshot);
+                }
+                else {
+                    queue.emplace_back(Tick{ static_cast<std::uint32_t>(at), kinds[at] });
+                }
+            }
+            for (const Message& message : queue) {
+                sum += consume(message);
+            }
+            queue.clear();
+        }
+        bench::do_not_optimize(sum);
+    }
+
+    template<std::size_t Count>
+    struct BoxedCases {
+        BoxedCases() {
+            const std::string prefix = "SkewedQueue/" + std::to_string(Count);
+            bench::Registrar(prefix + "/Boxed", fill_and_drain<BoxedMessage, Count>);
+            bench::Registrar(prefix + "/Variant", fill_and_drain<InlineMessage, Count>);
+            bench::Registrar(prefix + "/std::variant", fill_and_drain<StdMessage, Count>);
+        }
+    };
+
+    const BoxedCases<1024> cases1k;
+    const BoxedCases<(1 << 16)> cases64k;
+}
@@ -0,0 +1,119 @@
+#include "Benchmark.hpp"
+
+#include <array>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "VariantCollection.hpp"
+
+namespace {
+    struct Circle {
+        double radius;
+    };
+
+    struct Rectangle {
+        double width;
+        double height;
+    };
+
+    struct Polygon {
+        std::array<double, 6> sides;
+        double apothem;
+    };
+
+    double area(const Circle& circle) {
+        return 3.14159 * circle.radius * circle.radius;
+    }
+
+    double area(const Rectangle& rectangle) {
+        return rectangle.width * rectangle.height;
+    }
+
+    double area(const Polygon& polygon) {
+        double perimeter = 0;
+        for (double side : polygon.sides) {
+            perimeter += side;
+        }
+        return perimeter * polygon.apothem / 2;
+    }
+
+    // Count shapes of a random mix of the three kinds, the same for every
+    // container.
+    template<typename Insert>
+    void fill(std::size_t count, Insert&& insert) {
+        std::mt19937 engine(42);
+        for (std::size_t at = 0; at < count; ++at) {
+            const double size = static_cast<double>(engine() % 16 + 1);
+            switch (engine() % 3) {
+            case 0:
+                insert(Circle{ size });
+                break;
+            case 1:
+                insert(Rectangle{ size, size + 1 });
+                break;
+            default:
+                insert(Polygon{ { size, size, size, size, size, size }, size });
+                break;
+            }
+        }
+    }
+
+    template<std::size_t Count>
+    void sum_collection(bench::State& state) {
+        VariantCollection<Circle, Rectangle, Polygon> shapes;
+        fill(Count, [&shapes](auto shape) { shapes.insert(shape); });
+
+        double total = 0;
+        for (std::size_t i : state) {
+            (void)i;
+            shapes.for_each([&total](const auto& shape) { total += area(shape); });
+        }
+        bench::do_not_optimize(total);
+    }
+
+    template<std::size_t Count>
+    void sum_variants(bench::State& state) {
+        std::vector<Variant<Circle, Rectangle, Polygon>> shapes;
+        fill(Count, [&shapes](auto shape) { shapes.emplace_back(shape); });
+
+        double total = 0;
+        for (std::size_t i : state) {
+            (void)i;
+            for (const auto& shape : shapes) {
+                total += shape.visit([](const auto& alternative) { return area(alternative); });
+            }
+        }
+        bench::do_not_optimize(total);
+    }
+
+    template<std::size_t Count>
+    void sum_std_variants(bench::State& state) {
+        std::vector<std::variant<Circle, Rectangle, Polygon>> shapes;
+        fill(Count, [&shapes](auto shape) { shapes.emplace_back(shape); });
+
+        double total = 0;
+        for (std::size_t i : state) {
+            (void)i;
+            for (const auto& shape : shapes) {
+                total += std::visit([](const auto& alternative) { return area(alternative); }, shape);
+            }
+        }
+        bench::do_not_optimize(total);
+    }
+
+    template<std::size_t Count>
+    struct CollectionCases {
+        CollectionCases() {
+            const std::string prefix = "ShapeArea/" + std::to_string(Count);
+            bench::Registrar(prefix + "/Variant", sum_variants<Count>);
+            bench::Registrar(prefix + "/std::variant", sum_std_variants<Count>);
+            bench::Registrar(prefix + "/VariantCollection", sum_collection<Count>);
+        }
+    };
+
+    const CollectionCases<4096> cases4k;
+    const CollectionCases<(1 << 20)> cases1m;
+}
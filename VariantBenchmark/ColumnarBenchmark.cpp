@@ -0,0 +1,166 @@
+#include "Benchmark.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "VariantArray.hpp"
+
+namespace {
+    struct View {
+        std::uint64_t page;
+        std::uint64_t duration;
+    };
+
+    struct Click {
+        std::uint64_t page;
+        std::uint32_t x;
+        std::uint32_t y;
+    };
+
+    struct Purchase {
+        double amount;
+        std::uint64_t item;
+        std::uint64_t customer;
+    };
+
+    using Event = Variant<View, Click, Purchase>;
+    using StdEvent = std::variant<View, Click, Purchase>;
+
+    // Count events, one in a hundred a Purchase and the rest split between
+    // views and clicks.
+    template<typename Push>
+    void fill(std::size_t count, Push&& push) {
+        std::mt19937 engine(42);
+        for (std::size_t at = 0; at < count; ++at) {
+            const std::uint32_t kind = engine() % 100;
+            if (kind == 0) {
+                push(Purchase{ static_cast<double>(at % 50), at, at / 7 });
+            }
+            else if (kind % 2 == 0) {
+                push(View{ at, kind });
+            }
+            else {
+                push(Click{ at, kind, kind });
+            }
+        }
+    }
+
+    std::vector<Event> make_events(std::size_t count) {
+        std::vector<Event> events;
+        events.reserve(count);
+        fill(count, [&events](auto event) { events.emplace_back(event); });
+        return events;
+    }
+
+    std::vector<StdEvent> make_std_events(std::size_t count) {
+        std::vector<StdEvent> events;
+        events.reserve(count);
+        fill(count, [&events](auto event) { events.emplace_back(event); });
+        return events;
+    }
+
+    VariantArray<View, Click, Purchase> make_event_array(std::size_t count) {
+        VariantArray<View, Click, Purchase> events;
+        events.reserve(count);
+        fill(count, [&events](auto event) { events.push_back(event); });
+        return events;
+    }
+
+    // Tag-only pass: how many purchases.
+    template<std::size_t Count>
+    void count_variants(bench::State& state) {
+        const std::vector<Event> events = make_events(Count);
+        std::size_t total = 0;
+        for (std::size_t i : state) {
+            (void)i;
+            total += static_cast<std::size_t>(std::count_if(events.begin(), events.end(),
+                [](const Event& event) { return event.index() == 2; }));
+        }
+        bench::do_not_optimize(total);
+    }
+
+    template<std::size_t Count>
+    void count_std_variants(bench::State& state) {
+        const std::vector<StdEvent> events = make_std_events(Count);
+        std::size_t total = 0;
+        for (std::size_t i : state) {
+            (void)i;
+            total += static_cast<std::size_t>(std::count_if(events.begin(), events.end(),
+                [](const StdEvent& event) { return event.index() == 2; }));
+        }
+        bench::do_not_optimize(total);
+    }
+
+    template<std::size_t Count>
+    void count_array(bench::State& state) {
+        const auto events = make_event_array(Count);
+        std::size_t total = 0;
+        for (std::size_t i : state) {
+            (void)i;
+            total += events.count<Purchase>();
+        }
+        bench::do_not_optimize(total);
+    }
+
+    // Reads the payload of the rare alternative only: total revenue.
+    template<std::size_t Count>
+    void revenue_variants(bench::State& state) {
+        const std::vector<Event> events = make_events(Count);
+        double total = 0;
+        for (std::size_t i : state) {
+            (void)i;
+            for (const Event& event : events) {
+                if (const Purchase* purchase = event.get_if<Purchase>()) {
+                    total += purchase->amount;
+                }
+            }
+        }
+        bench::do_not_optimize(total);
+    }
+
+    template<std::size_t Count>
+    void revenue_std_variants(bench::State& state) {
+        const std::vector<StdEvent> events = make_std_events(Count);
+        double total = 0;
+        for (std::size_t i : state) {
+            (void)i;
+            for (const StdEvent& event : events) {
+                if (const Purchase* purchase = std::get_if<Purchase>(&event)) {
+                    total += purchase->amount;
+                }
+            }
+        }
+        bench::do_not_optimize(total);
+    }
+
+    template<std::size_t Count>
+    void revenue_array(bench::State& state) {
+        const auto events = make_event_array(Count);
+        double total = 0;
+        for (std::size_t i : state) {
+            (void)i;
+            events.for_each_of<Purchase>([&total](const Purchase& purchase) { total += purchase.amount; });
+        }
+        bench::do_not_optimize(total);
+    }
+
+    template<std::size_t Count>
+    struct ColumnarCases {
+        ColumnarCases() {
+            const std::string suffix = "/" + std::to_string(Count);
+            bench::Registrar("TagCount" + suffix + "/Variant", count_variants<Count>);
+            bench::Registrar("TagCount" + suffix + "/std::variant", count_std_variants<Count>);
+            bench::Registrar("TagCount" + suffix + "/VariantArray", count_array<Count>);
+            bench::Registrar("RareRevenue" + suffix + "/Variant", revenue_variants<Count>);
+            bench::Registrar("RareRevenue" + suffix + "/std::variant", revenue_std_variants<Count>);
+            bench::Registrar("RareRevenue" + suffix + "/VariantArray", revenue_array<Count>);
+        }
+    };
+
+    const ColumnarCases<(1 << 20)> cases1m;
+}
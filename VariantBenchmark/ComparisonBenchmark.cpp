@@ -0,0 +1,221 @@
+#include "Benchmark.hpp"
+#include "Payloads.hpp"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace {
+    constexpr std::size_t elements = 1024;
+
+    template<std::size_t I, typename... Types>
+    auto& get_alternative(Variant<Types...>& variant) {
+        return variant.template get<I>();
+    }
+
+    template<std::size_t I, typename... Types>
+    auto& get_alternative(std::variant<Types...>& variant) {
+        return std::get<I>(variant);
+    }
+
+    template<std::size_t I, typename... Types>
+    auto* get_alternative_if(Variant<Types...>& variant) {
+        return variant.template get_if<I>();
+    }
+
+    template<std::size_t I, typename... Types>
+    auto* get_alternative_if(std::variant<Types...>& variant) {
+        return std::get_if<I>(&variant);
+    }
+
+    // Same indices as source, or each index shifted by one alternative.
+    template<typename VariantType, std::size_t N>
+    std::vector<VariantType> make_targets(const std::vector<std::size_t>& indices, bool same) {
+        std::vector<VariantType> result;
+        result.reserve(indices.size());
+        for (std::size_t index : indices) {
+            result.push_back(bench::make_alternative<VariantType, N>(same ? index : (index + 1) % N));
+        }
+        return result;
+    }
+
+    template<typename VariantType, std::size_t N>
+    std::vector<VariantType> make_sources(const std::vector<std::size_t>& indices) {
+        return make_targets<VariantType, N>(indices, true);
+    }
+
+    template<typename VariantType, std::size_t N>
+    void construct(bench::State& state) {
+        using Last = std::remove_cvref_t<decltype(get_alternative<N - 1>(std::declval<VariantType&>()))>;
+        for ([[maybe_unused]] std::size_t i : state) {
+            VariantType variant(std::in_place_index<N - 1>, Last{});
+            bench::do_not_optimize(variant);
+        }
+    }
+
+    template<typename VariantType, std::size_t N>
+    void copy_construct(bench::State& state) {
+        const auto source = bench::random_variants<VariantType, N>(elements);
+        for (std::size_t i : state) {
+            VariantType copy(source[i % elements]);
+            bench::do_not_optimize(copy);
+        }
+    }
+
+    // Switches between the first and the last alternative on every call.
+    template<typename VariantType, std::size_t N>
+    void emplace(bench::State& state) {
+        VariantType variant;
+        for (std::size_t i : state) {
+            if (i % 2 == 0) {
+                variant.template emplace<N - 1>();
+            }
+            else {
+                variant.template emplace<0>();
+            }
+            bench::do_not_optimize(variant);
+        }
+    }
+
+    template<typename VariantType, std::size_t N, bool Same>
+    void copy_assign(bench::State& state) {
+        const auto indices = bench::random_indices(elements, N);
+        const auto source = make_sources<VariantType, N>(indices);
+        const auto initial = make_targets<VariantType, N>(indices, Same);
+        auto target = initial;
+        for (std::size_t i : state) {
+            const std::size_t at = i % elements;
+            if (at == 0) {
+                state.pause_timing();
+                target = initial;
+                state.resume_timing();
+            }
+            target[at] = source[at];
+            bench::do_not_optimize(target[at]);
+        }
+    }
+
+    template<typename VariantType, std::size_t N, bool Same>
+    void move_assign(bench::State& state) {
+        const auto indices = bench::random_indices(elements, N);
+        const auto initial_source = make_sources<VariantType, N>(indices);
+        const auto initial_target = make_targets<VariantType, N>(indices, Same);
+        auto source = initial_source;
+        auto target = initial_target;
+        for (std::size_t i : state) {
+            const std::size_t at = i % elements;
+            if (at == 0) {
+                state.pause_timing();
+                source = initial_source;
+                target = initial_target;
+                state.resume_timing();
+            }
+            target[at] = std::move(source[at]);
+            bench::do_not_optimize(target[at]);
+        }
+    }
+
+    template<typename VariantType, std::size_t N>
+    void swap(bench::State& state) {
+        auto lhs = bench::random_variants<VariantType, N>(elements, 1);
+        auto rhs = bench::random_variants<VariantType, N>(elements, 2);
+        for (std::size_t i : state) {
+            const std::size_t at = i % elements;
+            lhs[at].swap(rhs[at]);
+            bench::clobber_memory();
+        }
+    }
+
+    template<typename VariantType, std::size_t N>
+    void get(bench::State& state) {
+        std::vector<VariantType> variants(elements, bench::make_alternative<VariantType, N>(N - 1));
+        int sum = 0;
+        for (std::size_t i : state) {
+            sum += get_alternative<N - 1>(variants[i % elements]).value;
+        }
+        bench::do_not_optimize(sum);
+    }
+
+    template<typename VariantType, std::size_t N>
+    void get_if(bench::State& state) {
+        auto variants = bench::random_variants<VariantType, N>(elements);
+        int sum = 0;
+        for (std::size_t i : state) {
+            if (auto* alternative = get_alternative_if<0>(variants[i % elements])) {
+                sum += alternative->value;
+            }
+        }
+        bench::do_not_optimize(sum);
+    }
+
+    template<typename VariantType, std::size_t N>
+    void equality(bench::State& state) {
+        const auto lhs = bench::random_variants<VariantType, N>(elements);
+        const auto rhs = lhs;
+        std::size_t equal = 0;
+        for (std::size_t i : state) {
+            const std::size_t at = i % elements;
+            equal += lhs[at] == rhs[at];
+        }
+        bench::do_not_optimize(equal);
+    }
+
+    template<typename VariantType, std::size_t N>
+    void destroy(bench::State& state) {
+        const auto source = bench::random_variants<VariantType, N>(elements);
+        std::allocator<VariantType> allocator;
+        VariantType* objects = allocator.allocate(elements);
+        std::size_t constructed = 0;
+        for (std::size_t i : state) {
+            const std::size_t at = i % elements;
+            if (at == 0) {
+                state.pause_timing();
+                for (std::size_t j = 0; j < elements; ++j) {
+                    std::construct_at(objects + j, source[j]);
+                }
+                constructed = elements;
+                state.resume_timing();
+            }
+            std::destroy_at(objects + at);
+            --constructed;
+            bench::clobber_memory();
+        }
+        std::destroy(objects + (elements - constructed), objects + elements);
+        allocator.deallocate(objects, elements);
+    }
+
+    template<typename VariantType, typename StdVariantType, std::size_t N>
+    void register_cases(const std::string& group) {
+        const auto add = [&](const std::string& operation, bench::Body ours, bench::Body theirs) {
+            bench::Registrar(operation + "/" + group + "/Variant", std::move(ours));
+            bench::Registrar(operation + "/" + group + "/std::variant", std::move(theirs));
+        };
+        add("construct", construct<VariantType, N>, construct<StdVariantType, N>);
+        add("copy_construct", copy_construct<VariantType, N>, copy_construct<StdVariantType, N>);
+        add("emplace", emplace<VariantType, N>, emplace<StdVariantType, N>);
+        add("copy_assign/same", copy_assign<VariantType, N, true>, copy_assign<StdVariantType, N, true>);
+        add("copy_assign/different", copy_assign<VariantType, N, false>, copy_assign<StdVariantType, N, false>);
+        add("move_assign/same", move_assign<VariantType, N, true>, move_assign<StdVariantType, N, true>);
+        add("move_assign/different", move_assign<VariantType, N, false>, move_assign<StdVariantType, N, false>);
+        add("swap", swap<VariantType, N>, swap<StdVariantType, N>);
+        add("get", get<VariantType, N>, get<StdVariantType, N>);
+        add("get_if", get_if<VariantType, N>, get_if<StdVariantType, N>);
+        add("equality", equality<VariantType, N>, equality<StdVariantType, N>);
+        add("destroy", destroy<VariantType, N>, destroy<StdVariantType, N>);
+    }
+
+    template<std::size_t N>
+    struct ComparisonCases {
+        ComparisonCases() {
+            const std::string size = std::to_string(N);
+            register_cases<bench::PayloadVariant<N>, bench::StdPayloadVariant<N>, N>("trivial/" + size);
+            register_cases<bench::NonTrivialVariant<N>, bench::NonTrivialStdVariant<N>, N>("non_trivial/" + size);
+        }
+    };
+
+    const ComparisonCases<2> cases2;
+    const ComparisonCases<8> cases8;
+    const ComparisonCases<32> cases32;
+}
@@ -0,0 +1,34 @@
+// Compiled on its own by measure.sh with PACK_SIZE set to the number of
+// types; not part of the VariantBenchmark executable.
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "Auxiliary_meta_functions.hpp"
+
+#ifndef PACK_SIZE
+#define PACK_SIZE 16
+#endif
+
+namespace {
+    template<std::size_t I>
+    struct Element {};
+
+    template<typename Sequence>
+    struct Pack;
+
+    // Looks up every element by index and by type, as Variant does for each
+    // alternative it is instantiated with.
+    template<std::size_t... Is>
+    struct Pack<std::index_sequence<Is...>> {
+        static_assert(meta_functions::_Is_pack_of_different_type<Element<Is>...>);
+        static_assert((std::is_same_v<meta_functions::_Get_type_t<Is, Element<Is>...>, Element<Is>> && ...));
+        static_assert(((meta_functions::_Get_index_v<Element<Is>, Element<Is>...> == Is) && ...));
+    };
+}
+
+template struct Pack<std::make_index_sequence<PACK_SIZE>>;
+
+int main() {
+    return 0;
+}
@@ -0,0 +1,45 @@
+// Compiled on its own by measure.sh with PACK_SIZE set to the number of
+// alternatives; not part of the VariantBenchmark executable.
+#include <cstddef>
+#include <utility>
+
+#include "Variant.hpp"
+
+#ifndef PACK_SIZE
+#define PACK_SIZE 16
+#endif
+
+namespace {
+    template<std::size_t I>
+    struct Alternative {
+        int value = static_cast<int>(I);
+
+        bool operator==(const Alternative&) const = default;
+    };
+
+    template<typename Sequence>
+    struct Pack;
+
+    template<std::size_t... Is>
+    struct Pack<std::index_sequence<Is...>> {
+        using variant = Variant<Alternative<Is>...>;
+
+        // Touches every alternative by index and by type, which is what makes
+        // recursive lookups quadratic in the pack size.
+        static int exercise() {
+            variant v;
+            int sum = 0;
+            ((v.template emplace<Is>(),
+              sum += v.template get<Alternative<Is>>().value,
+              sum += v.template holds_alternative<Alternative<Is>>() ? 1 : 0), ...);
+            variant copy = v;
+            sum += copy == v ? 1 : 0;
+            sum += v.visit([](const auto& alternative) { return alternative.value; });
+            return sum;
+        }
+    };
+}
+
+int main() {
+    return Pack<std::make_index_sequence<PACK_SIZE>>::exercise() == 0;
+}
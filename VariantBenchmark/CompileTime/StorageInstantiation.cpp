@@ -0,0 +1,46 @@
+// Compiled on its own by measure.sh with PACK_SIZE set to the number of
+// alternatives and STORAGE set to VariadicUnion or FlatStorage; not part of
+// the VariantBenchmark executable.
+#include <cstddef>
+#include <utility>
+
+#include "FlatStorage.hpp"
+#include "VariadicUnion.hpp"
+
+#ifndef PACK_SIZE
+#define PACK_SIZE 16
+#endif
+
+#ifndef STORAGE
+#define STORAGE VariadicUnion
+#endif
+
+namespace {
+    template<std::size_t I>
+    struct Alternative {
+        int value = static_cast<int>(I);
+    };
+
+    template<typename Sequence>
+    struct Pack;
+
+    template<std::size_t... Is>
+    struct Pack<std::index_sequence<Is...>> {
+        using storage = STORAGE<Alternative<Is>...>;
+
+        // Creates, reads and destroys every alternative, which is what makes
+        // the recursive union instantiate N levels per alternative.
+        static int exercise() {
+            storage s;
+            int sum = 0;
+            ((s.template create<Alternative<Is>>(),
+              sum += s.template get<Alternative<Is>>().value,
+              s.template destroy<Alternative<Is>>()), ...);
+            return sum;
+        }
+    };
+}
+
+int main() {
+    return Pack<std::make_index_sequence<PACK_SIZE>>::exercise() == 0;
+}
@@ -0,0 +1,46 @@
+#!/bin/bash
+# Compiles MetaFunctions.cpp (pack lookups only), StorageInstantiation.cpp
+# (VariadicUnion and FlatStorage alone) and PackInstantiation.cpp (a whole
+# Variant) for each pack size and reports the wall time and, when GNU time is
+# installed, the peak memory of the compiler.
+# Usage: measure.sh [sizes...]   (default: 16 64 256; compiler from $CXX)
+set -e
+
+here=$(cd "$(dirname "$0")" && pwd)
+root=$(cd "$here/../.." && pwd)
+cxx=${CXX:-c++}
+out=$(mktemp -d)
+trap 'rm -rf "$out"' EXIT
+
+[ $# -gt 0 ] || set -- 16 64 256
+
+memory_probe=()
+if [ -x /usr/bin/time ]; then
+    memory_probe=(/usr/bin/time -f %M -o "$out/memory")
+fi
+
+TIMEFORMAT=%R
+printf '%-34s %10s %12s %14s\n' "Source" "Pack size" "Seconds" "Peak RSS (MB)"
+for target in MetaFunctions StorageInstantiation:VariadicUnion StorageInstantiation:FlatStorage \
+        PackInstantiation; do
+    source=${target%%:*}
+    storage=VariadicUnion
+    [ "$source" = "$target" ] || storage=${target#*:}
+    for size in "$@"; do
+        rm -f "$out/memory"
+        if ! seconds=$( { time "${memory_probe[@]}" "$cxx" -std=c++20 -O0 -c -DPACK_SIZE="$size" \
+                -DSTORAGE="$storage" \
+                -I"$root/Variant/Variant" \
+                -I"$root/VariadicUnion/VariadicUnion" \
+                -I"$root/Auxiliary_meta_functions/Auxiliary_meta_functions" \
+                "$here/$source.cpp" -o "$out/pack.o" 2> "$out/log"; } 2>&1 ); then
+            cat "$out/log" >&2
+            exit 1
+        fi
+        memory="n/a"
+        if [ -s "$out/memory" ]; then
+            memory=$(( $(tail -n 1 "$out/memory") / 1024 ))
+        fi
+        printf '%-34s %10s %12s %14s\n' "$target" "$size" "$seconds" "$memory"
+    done
+done
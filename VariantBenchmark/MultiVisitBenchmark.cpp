@@ -0,0 +1,113 @@
+#include "Benchmark.hpp"
+#include "Payloads.hpp"
+
+#include <string>
+
+namespace {
+    constexpr std::size_t elements = 1024;
+
+    struct Product {
+        template<typename... Payloads>
+        int operator()(const Payloads&... payloads) const {
+            return ((payloads.value + 1) * ...);
+        }
+    };
+
+    template<std::size_t N>
+    void flat_visit2(bench::State& state) {
+        auto lhs = bench::random_variants<bench::PayloadVariant<N>, N>(elements, 1);
+        auto rhs = bench::random_variants<bench::PayloadVariant<N>, N>(elements, 2);
+        int sum = 0;
+        for (std::size_t i : state) {
+            const std::size_t at = i % elements;
+            sum += visit(Product{}, lhs[at], rhs[at]);
+        }
+        bench::do_not_optimize(sum);
+    }
+
+    template<std::size_t N>
+    void nested_visit2(bench::State& state) {
+        auto lhs = bench::random_variants<bench::PayloadVariant<N>, N>(elements, 1);
+        auto rhs = bench::random_variants<bench::PayloadVariant<N>, N>(elements, 2);
+        int sum = 0;
+        for (std::size_t i : state) {
+            const std::size_t at = i % elements;
+            sum += lhs[at].visit([&](const auto& a) {
+                return rhs[at].visit([&](const auto& b) { return Product{}(a, b); });
+            });
+        }
+        bench::do_not_optimize(sum);
+    }
+
+    template<std::size_t N>
+    void std_visit2(bench::State& state) {
+        auto lhs = bench::random_variants<bench::StdPayloadVariant<N>, N>(elements, 1);
+        auto rhs = bench::random_variants<bench::StdPayloadVariant<N>, N>(elements, 2);
+        int sum = 0;
+        for (std::size_t i : state) {
+            const std::size_t at = i % elements;
+            sum += std::visit(Product{}, lhs[at], rhs[at]);
+        }
+        bench::do_not_optimize(sum);
+    }
+
+    template<std::size_t N>
+    void flat_visit3(bench::State& state) {
+        auto first = bench::random_variants<bench::PayloadVariant<N>, N>(elements, 1);
+        auto second = bench::random_variants<bench::PayloadVariant<N>, N>(elements, 2);
+        auto third = bench::random_variants<bench::PayloadVariant<N>, N>(elements, 3);
+        int sum = 0;
+        for (std::size_t i : state) {
+            const std::size_t at = i % elements;
+            sum += visit(Product{}, first[at], second[at], third[at]);
+        }
+        bench::do_not_optimize(sum);
+    }
+
+    template<std::size_t N>
+    void nested_visit3(bench::State& state) {
+        auto first = bench::random_variants<bench::PayloadVariant<N>, N>(elements, 1);
+        auto second = bench::random_variants<bench::PayloadVariant<N>, N>(elements, 2);
+        auto third = bench::random_variants<bench::PayloadVariant<N>, N>(elements, 3);
+        int sum = 0;
+        for (std::size_t i : state) {
+            const std::size_t at = i % elements;
+            sum += first[at].visit([&](const auto& a) {
+                return second[at].visit([&](const auto& b) {
+                    return third[at].visit([&](const auto& c) { return Product{}(a, b, c); });
+                });
+            });
+        }
+        bench::do_not_optimize(sum);
+    }
+
+    template<std::size_t N>
+    void std_visit3(bench::State& state) {
+        auto first = bench::random_variants<bench::StdPayloadVariant<N>, N>(elements, 1);
+        auto second = bench::random_variants<bench::StdPayloadVariant<N>, N>(elements, 2);
+        auto third = bench::random_variants<bench::StdPayloadVariant<N>, N>(elements, 3);
+        int sum = 0;
+        for (std::size_t i : state) {
+            const std::size_t at = i % elements;
+            sum += std::visit(Product{}, first[at], second[at], third[at]);
+        }
+        bench::do_not_optimize(sum);
+    }
+
+    template<std::size_t N>
+    struct MultiVisitCases {
+        MultiVisitCases() {
+            const std::string size = std::to_string(N);
+            bench::Registrar("MultiVisit/2x" + size + "/flat", flat_visit2<N>);
+            bench::Registrar("MultiVisit/2x" + size + "/nested", nested_visit2<N>);
+            bench::Registrar("MultiVisit/2x" + size + "/std::visit", std_visit2<N>);
+            bench::Registrar("MultiVisit/3x" + size + "/flat", flat_visit3<N>);
+            bench::Registrar("MultiVisit/3x" + size + "/nested", nested_visit3<N>);
+            bench::Registrar("MultiVisit/3x" + size + "/std::visit", std_visit3<N>);
+        }
+    };
+
+    const MultiVisitCases<4> cases4;
+    const MultiVisitCases<8> cases8;
+    const MultiVisitCases<16> cases16;
+}
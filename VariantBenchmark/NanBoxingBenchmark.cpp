@@ -0,0 +1,108 @@
+#include "Benchmark.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "NanBoxedVariant.hpp"
+#include "Variant.hpp"
+
+namespace {
+    struct Object {
+        double weight;
+    };
+
+    using Boxed = NanBoxedVariant<double, std::int32_t, bool, Object*>;
+    using Tagged = Variant<double, std::int32_t, bool, Object*>;
+    using Std = std::variant<double, std::int32_t, bool, Object*>;
+
+    static_assert(sizeof(Boxed) == 8);
+    static_assert(sizeof(Tagged) == 16);
+
+    struct AsNumber {
+        double operator()(double value) const { return value; }
+        double operator()(std::int32_t value) const { return value; }
+        double operator()(bool value) const { return value ? 1.0 : 0.0; }
+        double operator()(Object* object) const { return object->weight; }
+    };
+
+    template<typename Value>
+    double as_number(const Value& value) {
+        return value.visit(AsNumber{});
+    }
+
+    double as_number(const Std& value) {
+        return std::visit(AsNumber{}, value);
+    }
+
+    // Mostly doubles, as in a script doing numeric work, with some integers
+    // and a few booleans and objects.
+    template<typename Value>
+    std::vector<Value> random_values(std::size_t count, std::vector<Object>& objects) {
+        std::mt19937 engine(42);
+        objects.assign(64, Object{ 0.5 });
+        std::vector<Value> values;
+        values.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto random = static_cast<std::uint32_t>(engine());
+            const auto percent = random % 100;
+            if (percent < 70) {
+                values.emplace_back(static_cast<double>(random % 1000) / 8.0);
+            }
+            else if (percent < 90) {
+                values.emplace_back(static_cast<std::int32_t>(random % 1000));
+            }
+            else if (percent < 95) {
+                values.emplace_back(random % 2 == 0);
+            }
+            else {
+                values.emplace_back(&objects[random % objects.size()]);
+            }
+        }
+        return values;
+    }
+
+    template<typename Value, std::size_t Count>
+    void sum(bench::State& state) {
+        std::vector<Object> objects;
+        const auto values = random_values<Value>(Count, objects);
+        double total = 0;
+        for (std::size_t i : state) {
+            total += as_number(values[i % Count]);
+        }
+        bench::do_not_optimize(total);
+    }
+
+    // Reads two operands and writes back a double result, as an interpreter's
+    // arithmetic instruction does.
+    template<typename Value, std::size_t Count>
+    void multiply_add(bench::State& state) {
+        std::vector<Object> objects;
+        auto values = random_values<Value>(Count, objects);
+        for (std::size_t i : state) {
+            const std::size_t at = i % Count;
+            const std::size_t next = (at + 1) % Count;
+            values[at] = as_number(values[at]) * 0.5 + as_number(values[next]);
+        }
+        bench::do_not_optimize(values);
+    }
+
+    template<std::size_t Count>
+    struct NanBoxingCases {
+        NanBoxingCases() {
+            const std::string size = std::to_string(Count);
+            bench::Registrar("Arithmetic/" + size + "/sum/NanBoxedVariant", sum<Boxed, Count>);
+            bench::Registrar("Arithmetic/" + size + "/sum/Variant", sum<Tagged, Count>);
+            bench::Registrar("Arithmetic/" + size + "/sum/std::variant", sum<Std, Count>);
+            bench::Registrar("Arithmetic/" + size + "/multiply_add/NanBoxedVariant", multiply_add<Boxed, Count>);
+            bench::Registrar("Arithmetic/" + size + "/multiply_add/Variant", multiply_add<Tagged, Count>);
+            bench::Registrar("Arithmetic/" + size + "/multiply_add/std::variant", multiply_add<Std, Count>);
+        }
+    };
+
+    const NanBoxingCases<1024> cases1k;
+    const NanBoxingCases<(1 << 22)> cases4m;
+}
@@ -0,0 +1,86 @@
+#include "Benchmark.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Variant.hpp"
+
+namespace {
+    enum class Kind : std::uint8_t { file, socket, pipe };
+
+    // Identical layouts; only NicheHandle advertises the spare values of kind.
+    struct NicheHandle {
+        std::uint32_t id;
+        Kind kind;
+    };
+
+    struct TaggedHandle {
+        std::uint32_t id;
+        Kind kind;
+    };
+}
+
+template<>
+struct meta_functions::niche_traits<NicheHandle>
+    : meta_functions::value_niche_traits<Kind, Kind::pipe, offsetof(NicheHandle, kind)> {};
+
+template<>
+struct meta_functions::enable_compact_layout<NicheHandle, bool, Kind, std::uint16_t> : std::true_type {};
+
+namespace {
+    using NicheVariant = Variant<NicheHandle, bool, Kind, std::uint16_t>;
+    using TaggedVariant = Variant<TaggedHandle, bool, Kind, std::uint16_t>;
+
+    static_assert(sizeof(NicheVariant) < sizeof(TaggedVariant));
+
+    template<typename VariantType>
+    std::vector<VariantType> random_handles(std::size_t count) {
+        std::mt19937 engine(42);
+        std::vector<VariantType> variants;
+        variants.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto value = static_cast<std::uint32_t>(engine());
+            switch (value % 4) {
+            case 0: variants.emplace_back(std::in_place_index<0>, value, Kind(value % 3)); break;
+            case 1: variants.emplace_back(value % 2 == 0); break;
+            case 2: variants.emplace_back(Kind(value % 3)); break;
+            default: variants.emplace_back(static_cast<std::uint16_t>(value)); break;
+            }
+        }
+        return variants;
+    }
+
+    // Reads the index of every element, then the active alternative: the niche
+    // layout decodes the index from the handle's kind byte instead of loading
+    // a separate tag, and packs more elements into each cache line.
+    template<typename VariantType, std::size_t Count>
+    void sum_by_index(bench::State& state) {
+        const auto variants = random_handles<VariantType>(Count);
+        std::uint64_t sum = 0;
+        for (std::size_t i : state) {
+            const auto& variant = variants[i % Count];
+            switch (variant.index()) {
+            case 0: sum += variant.template get<0>().id; break;
+            case 1: sum += variant.template get<1>(); break;
+            case 2: sum += static_cast<std::uint64_t>(variant.template get<2>()); break;
+            default: sum += variant.template get<3>(); break;
+            }
+        }
+        bench::do_not_optimize(sum);
+    }
+
+    template<std::size_t Count>
+    struct NicheCases {
+        NicheCases() {
+            const std::string prefix = "SumByIndex/" + std::to_string(Count);
+            bench::Registrar(prefix + "/niche", sum_by_index<NicheVariant, Count>);
+            bench::Registrar(prefix + "/tagged", sum_by_index<TaggedVariant, Count>);
+        }
+    };
+
+    const NicheCases<1024> cases1k;
+    const NicheCases<(1 << 22)> cases4m;
+}
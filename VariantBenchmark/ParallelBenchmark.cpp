@@ -0,0 +1,77 @@
+#include "Benchmark.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Payloads.hpp"
+#include "VariantParallel.hpp"
+
+namespace {
+    constexpr std::size_t alternatives = 16;
+    constexpr std::size_t count = 1 << 24;
+
+    using Value = bench::PayloadVariant<alternatives>;
+
+    const std::vector<Value>& values() {
+        static const std::vector<Value> result = bench::random_variants<Value, alternatives>(count);
+        return result;
+    }
+
+    // Costs from one to eight rounds depending on the alternative, so equal
+    // shares of the range are unequal shares of the work.
+    struct Hash {
+        template<std::size_t I>
+        unsigned operator()(const bench::Payload<I>& payload) const noexcept {
+            unsigned hash = static_cast<unsigned>(payload.value);
+            for (std::size_t round = 0; round < I % 8 + 1; ++round) {
+                hash = (hash ^ (hash >> 15)) * 0x2c1b3c6du;
+            }
+            return hash;
+        }
+    };
+
+    void serial_reduce(bench::State& state) {
+        const std::vector<Value>& data = values();
+        unsigned total = 0;
+        for (std::size_t i : state) {
+            (void)i;
+            for (const Value& value : data) {
+                total += value.visit(Hash{});
+            }
+        }
+        bench::do_not_optimize(total);
+    }
+
+    void parallel_reduce(bench::State& state, std::size_t threads) {
+        const std::vector<Value>& data = values();
+        VariantThreadPool pool(threads);
+        unsigned total = 0;
+        for (std::size_t i : state) {
+            (void)i;
+            total += parallel_transform_reduce(pool, data, 0u, std::plus<>{}, Hash{});
+        }
+        bench::do_not_optimize(total);
+    }
+
+    struct ParallelCases {
+        ParallelCases() {
+            const std::size_t bytes = count * sizeof(Value);
+            bench::Registrar("Parallel/transform_reduce/serial", serial_reduce, bytes);
+            const std::size_t hardware = std::max(std::thread::hardware_concurrency(), 1u);
+            for (std::size_t threads = 1; ; threads = std::min(threads * 2, hardware)) {
+                bench::Registrar("Parallel/transform_reduce/threads:" + std::to_string(threads),
+                    [threads](bench::State& state) { parallel_reduce(state, threads); }, bytes);
+                if (threads == hardware) {
+                    break;
+                }
+            }
+        }
+    };
+
+    const ParallelCases cases;
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include <cstddef>
+#include <random>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "Variant.hpp"
+
+namespace bench {
+    template<std::size_t I>
+    struct Payload {
+        int value = static_cast<int>(I);
+
+        bool operator==(const Payload&) const = default;
+    };
+
+    // Same layout as Payload, but with user-provided special members, so a
+    // variant of them goes through the non-trivial code paths.
+    template<std::size_t I>
+    struct NonTrivialPayload {
+        int value = static_cast<int>(I);
+
+        NonTrivialPayload() = default;
+        NonTrivialPayload(const NonTrivialPayload& other) : value(other.value) {}
+        NonTrivialPayload(NonTrivialPayload&& other) noexcept : value(other.value) {}
+        ~NonTrivialPayload() {}
+
+        NonTrivialPayload& operator=(const NonTrivialPayload& other) {
+            value = other.value;
+            return *this;
+        }
+
+        NonTrivialPayload& operator=(NonTrivialPayload&& other) noexcept {
+            value = other.value;
+            return *this;
+        }
+
+        bool operator==(const NonTrivialPayload& other) const {
+            return value == other.value;
+        }
+    };
+
+    template<typename Sequence>
+    struct _Payload_pack;
+
+    template<std::size_t... Is>
+    struct _Payload_pack<std::index_sequence<Is...>> {
+        using variant = Variant<Payload<Is>...>;
+        using std_variant = std::variant<Payload<Is>...>;
+        using non_trivial_variant = Variant<NonTrivialPayload<Is>...>;
+        using non_trivial_std_variant = std::variant<NonTrivialPayload<Is>...>;
+    };
+
+    template<std::size_t N>
+    using PayloadVariant = typename _Payload_pack<std::make_index_sequence<N>>::variant;
+
+    template<std::size_t N>
+    using StdPayloadVariant = typename _Payload_pack<std::make_index_sequence<N>>::std_variant;
+
+    template<std::size_t N>
+    using NonTrivialVariant = typename _Payload_pack<std::make_index_sequence<N>>::non_trivial_variant;
+
+    template<std::size_t N>
+    using NonTrivialStdVariant = typename _Payload_pack<std::make_index_sequence<N>>::non_trivial_std_variant;
+
+    template<typename VariantType, std::size_t... Is>
+    VariantType _make_alternative(std::size_t index, std::index_sequence<Is...>) {
+        VariantType result;
+        ((index == Is ? (void)result.template emplace<Is>() : void()), ...);
+        return result;
+    }
+
+    // Default-constructs the index-th alternative of either Variant or std::variant.
+    template<typename VariantType, std::size_t N>
+    VariantType make_alternative(std::size_t index) {
+        return _make_alternative<VariantType>(index, std::make_index_sequence<N>{});
+    }
+
+    inline std::vector<std::size_t> random_indices(std::size_t count, std::size_t bound,
+        unsigned seed = 42) {
+        std::mt19937 engine(seed);
+        std::uniform_int_distribution<std::size_t> distribution(0, bound - 1);
+        std::vector<std::size_t> indices(count);
+        for (std::size_t& index : indices) {
+            index = distribution(engine);
+        }
+        return indices;
+    }
+
+    template<typename VariantType, std::size_t N>
+    std::vector<VariantType> random_variants(std::size_t count, unsigned seed = 42) {
+        std::vector<VariantType> result;
+        result.reserve(count);
+        for (std::size_t index : random_indices(count, N, seed)) {
+            result.push_back(make_alternative<VariantType, N>(index));
+        }
+        return result;
+    }
+}
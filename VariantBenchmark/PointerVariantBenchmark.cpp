@@ -0,0 +1,90 @@
+#include "Benchmark.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "PointerVariant.hpp"
+#include "Variant.hpp"
+
+namespace {
+    struct Leaf {
+        std::uint32_t value;
+    };
+
+    // A binary tree whose child links are either PointerVariant or Variant.
+    template<template<typename...> class Link>
+    struct Inner {
+        Link<Inner*, Leaf*> left;
+        Link<Inner*, Leaf*> right;
+    };
+
+    template<template<typename...> class Link>
+    struct Tree {
+        using Child = Link<Inner<Link>*, Leaf*>;
+
+        std::deque<Inner<Link>> inners;
+        std::deque<Leaf> leaves;
+        Child root;
+    };
+
+    // Random shape, so the branch on each child's index is unpredictable.
+    // Both trees are built from the same seed and have the same shape.
+    template<template<typename...> class Link>
+    typename Tree<Link>::Child grow(Tree<Link>& tree, std::mt19937& engine, std::size_t depth) {
+        const auto value = static_cast<std::uint32_t>(engine());
+        if (depth == 0 || value % 4 == 0) {
+            return typename Tree<Link>::Child(&tree.leaves.emplace_back(Leaf{ value }));
+        }
+        Inner<Link>& inner = tree.inners.emplace_back();
+        inner.left = grow(tree, engine, depth - 1);
+        inner.right = grow(tree, engine, depth - 1);
+        return typename Tree<Link>::Child(&inner);
+    }
+
+    // Walks the whole tree with an explicit stack of child links: the tagged
+    // Variant link is twice the size of a pointer, PointerVariant is a pointer.
+    template<template<typename...> class Link, std::size_t Depth>
+    void sum_leaves(bench::State& state) {
+        Tree<Link> tree;
+        std::mt19937 engine(42);
+        tree.root = grow(tree, engine, Depth);
+
+        std::vector<typename Tree<Link>::Child> stack;
+        std::uint64_t sum = 0;
+        for (std::size_t i : state) {
+            (void)i;
+            stack.push_back(tree.root);
+            while (!stack.empty()) {
+                const auto child = stack.back();
+                stack.pop_back();
+                if (child.index() == 0) {
+                    Inner<Link>* inner = child.template get<0, VariantAccessPolicy::unchecked>();
+                    stack.push_back(inner->right);
+                    stack.push_back(inner->left);
+                }
+                else {
+                    sum += child.template get<1, VariantAccessPolicy::unchecked>()->value;
+                }
+            }
+        }
+        bench::do_not_optimize(sum);
+    }
+
+    static_assert(sizeof(PointerVariant<Inner<PointerVariant>*, Leaf*>) == sizeof(void*));
+
+    template<std::size_t Depth>
+    struct PointerVariantCases {
+        PointerVariantCases() {
+            const std::string prefix = "TreeTraversal/depth" + std::to_string(Depth);
+            bench::Registrar(prefix + "/pointer_variant", sum_leaves<PointerVariant, Depth>);
+            bench::Registrar(prefix + "/variant", sum_leaves<Variant, Depth>);
+        }
+    };
+
+    const PointerVariantCases<10> cases10;
+    const PointerVariantCases<20> cases20;
+}
@@ -0,0 +1,141 @@
+#include "Benchmark.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "Variant.hpp"
+
+namespace {
+    // A power of two: both buffers are exactly full after this many insertions.
+    constexpr std::size_t elements = 4096;
+
+    // Minimal vector that doubles its capacity on growth. Relocate selects
+    // relocate_range for moving the old elements; otherwise they are
+    // move-constructed and destroyed one by one, as std::vector does.
+    template<typename Type, bool Relocate>
+    class GrowingBuffer {
+    public:
+        GrowingBuffer() = default;
+        GrowingBuffer(const GrowingBuffer&) = delete;
+        GrowingBuffer& operator=(const GrowingBuffer&) = delete;
+
+        ~GrowingBuffer() {
+            std::destroy(_data, _data + _size);
+            _deallocate(_data);
+        }
+
+        template<typename... Args>
+        void emplace_back(Args&&... args) {
+            if (_size == _capacity) {
+                _grow(_capacity == 0 ? 1 : _capacity * 2);
+            }
+            std::construct_at(_data + _size, std::forward<Args>(args)...);
+            ++_size;
+        }
+
+        std::size_t size() const { return _size; }
+
+    private:
+        static Type* _allocate(std::size_t count) {
+            return static_cast<Type*>(::operator new(count * sizeof(Type), std::align_val_t(alignof(Type))));
+        }
+
+        static void _deallocate(Type* data) {
+            ::operator delete(data, std::align_val_t(alignof(Type)));
+        }
+
+        void _grow(std::size_t capacity) {
+            Type* data = _allocate(capacity);
+            if constexpr (Relocate) {
+                relocate_range(_data, _data + _size, data);
+            }
+            else {
+                std::uninitialized_move(_data, _data + _size, data);
+                std::destroy(_data, _data + _size);
+            }
+            _deallocate(_data);
+            _data = data;
+            _capacity = capacity;
+        }
+
+        Type* _data = nullptr;
+        std::size_t _size = 0;
+        std::size_t _capacity = 0;
+    };
+
+    // Long enough to be allocated, so moving one is more than a copy of its bytes.
+    template<typename Text>
+    Text make_text() {
+        if constexpr (std::is_same_v<Text, std::string>) {
+            return std::string(32, 'x');
+        }
+        else {
+            return std::make_unique<std::string>(32, 'x');
+        }
+    }
+
+    // std::string is not trivially relocatable in every standard library
+    // (libstdc++ points into its own small buffer), so a Variant holding it
+    // falls back to move and destroy there; a boxed string relocates everywhere.
+    template<typename Text>
+    using TextOrPointer = Variant<Text, std::unique_ptr<int>>;
+
+    template<typename Text, typename Buffer>
+    void fill(Buffer& buffer, std::size_t count) {
+        for (std::size_t element = 0; element < count; ++element) {
+            if (element % 2 == 0) {
+                buffer.emplace_back(std::make_unique<int>(static_cast<int>(element)));
+            }
+            else {
+                buffer.emplace_back(make_text<Text>());
+            }
+        }
+    }
+
+    // Times only the growth step: the buffer is filled to its capacity
+    // outside the timed region and the next element makes it reallocate.
+    template<typename Buffer, typename Text>
+    void grow_once(bench::State& state) {
+        for ([[maybe_unused]] std::size_t i : state) {
+            state.pause_timing();
+            {
+                auto buffer = std::make_unique<Buffer>();
+                fill<Text>(*buffer, elements);
+                state.resume_timing();
+                buffer->emplace_back(std::make_unique<int>(0));
+                state.pause_timing();
+                bench::do_not_optimize(*buffer);
+            }
+            state.resume_timing();
+        }
+    }
+
+    template<typename Text, bool Relocate>
+    void grow(bench::State& state) {
+        grow_once<GrowingBuffer<TextOrPointer<Text>, Relocate>, Text>(state);
+    }
+
+    template<typename Text>
+    void grow_std_vector(bench::State& state) {
+        grow_once<std::vector<TextOrPointer<Text>>, Text>(state);
+    }
+
+    using Boxed = std::unique_ptr<std::string>;
+
+    const bench::Registrar string_vector("VectorGrowth/string|unique_ptr/std::vector",
+        grow_std_vector<std::string>);
+    const bench::Registrar string_move("VectorGrowth/string|unique_ptr/move",
+        grow<std::string, false>);
+    const bench::Registrar string_relocate("VectorGrowth/string|unique_ptr/relocate",
+        grow<std::string, true>);
+    const bench::Registrar boxed_vector("VectorGrowth/unique_ptr<string>|unique_ptr/std::vector",
+        grow_std_vector<Boxed>);
+    const bench::Registrar boxed_move("VectorGrowth/unique_ptr<string>|unique_ptr/move",
+        grow<Boxed, false>);
+    const bench::Registrar boxed_relocate("VectorGrowth/unique_ptr<string>|unique_ptr/relocate",
+        grow<Boxed, true>);
+}
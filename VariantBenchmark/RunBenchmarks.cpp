@@ -0,0 +1,5 @@
+#include "Benchmark.hpp"
+
+int main(int argc, char** argv) {
+    return bench::run_all(argc > 1 ? argv[1] : "");
+}
@@ -0,0 +1,53 @@
+#include "Benchmark.hpp"
+#include "Payloads.hpp"
+
+#include <string>
+
+#include "../VariadicUnion/VariadicUnion/FlatStorage.hpp"
+#include "../VariadicUnion/VariadicUnion/VariadicUnion.hpp"
+
+// Most telling in a debug build, where every level of the recursive union is a
+// call of its own; an optimized build inlines both storages to the same code.
+namespace {
+    template<typename Sequence>
+    struct _Storage_pack;
+
+    template<std::size_t... Is>
+    struct _Storage_pack<std::index_sequence<Is...>> {
+        using recursive = VariadicUnion<bench::NonTrivialPayload<Is>...>;
+        using flat = FlatStorage<bench::NonTrivialPayload<Is>...>;
+    };
+
+    // Creates, reads and destroys the last alternative, the deepest one in
+    // the recursive union.
+    template<typename Storage, std::size_t N>
+    void create_get_destroy_last(bench::State& state) {
+        using Last = bench::NonTrivialPayload<N - 1>;
+        Storage storage;
+        int sum = 0;
+        for ([[maybe_unused]] std::size_t i : state) {
+            storage.template create<Last>();
+            sum += storage.template get<Last>().value;
+            storage.template destroy<Last>();
+            bench::clobber_memory();
+        }
+        bench::do_not_optimize(sum);
+    }
+
+    template<std::size_t N>
+    struct StorageCases {
+        using Pack = _Storage_pack<std::make_index_sequence<N>>;
+
+        StorageCases() {
+            const std::string size = std::to_string(N);
+            bench::Registrar("Storage/" + size + "/create_get_destroy_last/VariadicUnion",
+                create_get_destroy_last<typename Pack::recursive, N>);
+            bench::Registrar("Storage/" + size + "/create_get_destroy_last/FlatStorage",
+                create_get_destroy_last<typename Pack::flat, N>);
+        }
+    };
+
+    const StorageCases<8> cases8;
+    const StorageCases<32> cases32;
+    const StorageCases<128> cases128;
+}
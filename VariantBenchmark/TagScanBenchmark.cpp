@@ -0,0 +1,165 @@
+#include "Benchmark.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "VariantAlgorithms.hpp"
+
+namespace {
+    namespace detail = variant_detail;
+
+    constexpr std::size_t alternatives = 4;
+
+    std::vector<std::uint8_t> random_tags(std::size_t size) {
+        std::mt19937 engine(42);
+        std::vector<std::uint8_t> tags(size);
+        for (auto& tag : tags) {
+            tag = static_cast<std::uint8_t>(engine() % alternatives);
+        }
+        return tags;
+    }
+
+    template<std::size_t (*Count)(const std::uint8_t*, std::size_t, std::uint8_t), std::size_t Size>
+    void count_tags(bench::State& state) {
+        const std::vector<std::uint8_t> tags = random_tags(Size);
+        std::size_t total = 0;
+        for (std::size_t i : state) {
+            (void)i;
+            total += Count(tags.data(), tags.size(), 3);
+            bench::clobber_memory();
+        }
+        bench::do_not_optimize(total);
+    }
+
+    template<void (*Histogram)(const std::uint8_t*, std::size_t, std::size_t*), std::size_t Size>
+    void histogram_tags(bench::State& state) {
+        const std::vector<std::uint8_t> tags = random_tags(Size);
+        std::array<std::size_t, alternatives> counts{};
+        for (std::size_t i : state) {
+            (void)i;
+            Histogram(tags.data(), tags.size(), counts.data());
+            bench::clobber_memory();
+        }
+        bench::do_not_optimize(counts);
+    }
+
+    template<std::size_t Size>
+    void partition_array(bench::State& state) {
+        const std::vector<std::uint8_t> tags = random_tags(Size);
+        VariantArray<int, float, std::uint16_t, char> array;
+        array.reserve(Size);
+        for (const std::uint8_t tag : tags) {
+            switch (tag) {
+            case 0:
+                array.push_back(1);
+                break;
+            case 1:
+                array.push_back(1.0f);
+                break;
+            case 2:
+                array.push_back(std::uint16_t(1));
+                break;
+            default:
+                array.push_back('a');
+                break;
+            }
+        }
+        std::size_t total = 0;
+        for (std::size_t i : state) {
+            (void)i;
+            total += partition_by_index(array)[3].size();
+        }
+        bench::do_not_optimize(total);
+    }
+
+    template<typename Values>
+    Values make_values(std::size_t size) {
+        const std::vector<std::uint8_t> tags = random_tags(size);
+        Values values;
+        values.reserve(size);
+        for (const std::uint8_t tag : tags) {
+            switch (tag) {
+            case 0:
+                values.emplace_back(1);
+                break;
+            case 1:
+                values.emplace_back(1.0f);
+                break;
+            case 2:
+                values.emplace_back(std::uint16_t(1));
+                break;
+            default:
+                values.emplace_back('a');
+                break;
+            }
+        }
+        return values;
+    }
+
+    // count_alternative over a vector of Variants reads every element.
+    template<std::size_t Size>
+    void count_variants(bench::State& state) {
+        const auto values = make_values<std::vector<Variant<int, float, std::uint16_t, char>>>(Size);
+        std::size_t total = 0;
+        for (std::size_t i : state) {
+            (void)i;
+            total += count_alternative<char>(values);
+        }
+        bench::do_not_optimize(total);
+    }
+
+    template<std::size_t Size>
+    void count_std_variants(bench::State& state) {
+        const auto values = make_values<std::vector<std::variant<int, float, std::uint16_t, char>>>(Size);
+        std::size_t total = 0;
+        for (std::size_t i : state) {
+            (void)i;
+            total += static_cast<std::size_t>(std::count_if(values.begin(), values.end(),
+                [](const auto& value) { return std::holds_alternative<char>(value); }));
+        }
+        bench::do_not_optimize(total);
+    }
+
+    template<std::size_t Size>
+    struct TagScanCases {
+        TagScanCases() {
+            const std::string size = std::to_string(Size);
+            bench::Registrar("TagScan/count/" + size + "/scalar",
+                count_tags<detail::_Count_tag_scalar, Size>, Size);
+#ifdef VARIANT_X86_SIMD
+            if (detail::_Supported_simd_level() >= detail::_Simd_level::sse2) {
+                bench::Registrar("TagScan/count/" + size + "/sse2",
+                    count_tags<detail::_Count_tag_sse2, Size>, Size);
+            }
+            if (detail::_Supported_simd_level() >= detail::_Simd_level::avx2) {
+                bench::Registrar("TagScan/count/" + size + "/avx2",
+                    count_tags<detail::_Count_tag_avx2, Size>, Size);
+            }
+#endif
+            bench::Registrar("TagScan/histogram/" + size + "/scalar",
+                histogram_tags<detail::_Tag_histogram_scalar, Size>, Size);
+#ifdef VARIANT_X86_SIMD
+            if (detail::_Supported_simd_level() >= detail::_Simd_level::sse2) {
+                bench::Registrar("TagScan/histogram/" + size + "/sse2",
+                    histogram_tags<detail::_Tag_histogram_sse2<alternatives>, Size>, Size);
+            }
+            if (detail::_Supported_simd_level() >= detail::_Simd_level::avx2) {
+                bench::Registrar("TagScan/histogram/" + size + "/avx2",
+                    histogram_tags<detail::_Tag_histogram_avx2<alternatives>, Size>, Size);
+            }
+#endif
+            bench::Registrar("TagScan/partition_by_index/" + size + "/VariantArray", partition_array<Size>, Size);
+            bench::Registrar("TagScan/count_alternative/" + size + "/Variant", count_variants<Size>);
+            bench::Registrar("TagScan/count_alternative/" + size + "/std::variant", count_std_variants<Size>);
+        }
+    };
+
+    const TagScanCases<(1 << 16)> cases64k;
+    const TagScanCases<(1 << 24)> cases16m;
+}
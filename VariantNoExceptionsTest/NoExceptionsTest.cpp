@@ -0,0 +1,139 @@
+#include "pch.h"
+#include "Variant.hpp"
+#include <cstdio>
+#include <memory>
+#include <new>
+#include <string>
+
+#ifndef VARIANT_NO_EXCEPTIONS
+#error "This test target must be built with exceptions disabled"
+#endif
+
+namespace {
+    // Its move constructor is not noexcept, so a moved-from Variant of it
+    // becomes valueless.
+    struct MaybeThrowingMove {
+        int value = 0;
+
+        MaybeThrowingMove() = default;
+        MaybeThrowingMove(int v) : value(v) {}
+        MaybeThrowingMove(const MaybeThrowingMove&) = default;
+        MaybeThrowingMove(MaybeThrowingMove&& other) : value(other.value) {}
+        MaybeThrowingMove& operator=(const MaybeThrowingMove&) = default;
+        MaybeThrowingMove& operator=(MaybeThrowingMove&&) = default;
+
+        bool operator==(const MaybeThrowingMove&) const = default;
+    };
+
+    void report_access_error(VariantAccessError error) {
+        std::fputs(error == VariantAccessError::valueless
+            ? "bad access: valueless\n"
+            : "bad access: wrong alternative\n", stderr);
+    }
+
+    using V = Variant<int, std::string, MaybeThrowingMove>;
+}
+
+TEST(NoExceptionsTest, ConstructsAndAssigns) {
+    V v;
+    EXPECT_EQ(v.index(), 0);
+    v = std::string("text");
+    EXPECT_EQ(v.get<std::string>(), "text");
+
+    V copy(v);
+    V moved(std::in_place_index<2>, 7);
+    moved = copy;
+    EXPECT_EQ(moved.get<1>(), "text");
+
+    V other(5);
+    other = std::move(moved);
+    EXPECT_EQ(other.index(), 1);
+}
+
+TEST(NoExceptionsTest, Emplaces) {
+    V v;
+    EXPECT_EQ(v.emplace<std::string>(3, 'x'), "xxx");
+    EXPECT_EQ(v.emplace<2>(4).value, 4);
+    EXPECT_TRUE(v.holds_alternative<MaybeThrowingMove>());
+}
+
+TEST(NoExceptionsTest, SwapsAndCompares) {
+    V v1(1), v2(std::string("two"));
+    v1.swap(v2);
+    EXPECT_EQ(v1.get<std::string>(), "two");
+    EXPECT_EQ(v2.get<int>(), 1);
+    EXPECT_TRUE(v1 == V(std::string("two")));
+    EXPECT_TRUE(v1 != v2);
+}
+
+TEST(NoExceptionsTest, AccessorsReportFailuresWithoutThrowing) {
+    V v(std::string("text"));
+    EXPECT_EQ(v.get_if<int>(), nullptr);
+    ASSERT_NE(v.get_if<1>(), nullptr);
+
+    auto hit = v.try_get<std::string>();
+    ASSERT_TRUE(hit);
+    EXPECT_EQ(hit.value(), "text");
+
+    auto miss = v.try_get<0>();
+    EXPECT_FALSE(miss);
+    EXPECT_EQ(miss.error(), VariantAccessError::wrong_alternative);
+}
+
+TEST(NoExceptionsTest, MovedFromVariantIsReportedValueless) {
+    Variant<MaybeThrowingMove, int> source(3);
+    Variant<MaybeThrowingMove, int> target(std::move(source));
+    EXPECT_TRUE(source.valueless_by_exception());
+    EXPECT_EQ(source.try_get<int>().error(), VariantAccessError::valueless);
+    EXPECT_EQ(target.get<int>(), 3);
+}
+
+TEST(NoExceptionsTest, Visits) {
+    V v(std::string("abc"));
+    EXPECT_EQ(v.visit([](const auto& value) { return sizeof(value); }), sizeof(std::string));
+
+    V other(2);
+    const int sum = visit([](const auto& lhs, const auto& rhs) {
+        if constexpr (std::is_same_v<std::remove_cvref_t<decltype(lhs)>, int> &&
+            std::is_same_v<std::remove_cvref_t<decltype(rhs)>, int>) {
+            return lhs + rhs;
+        }
+        else {
+            return -1;
+        }
+    }, other, other);
+    EXPECT_EQ(sum, 4);
+}
+
+TEST(NoExceptionsTest, Relocates) {
+    using R = Variant<int, std::unique_ptr<int>>;
+    alignas(R) std::byte source[sizeof(R)];
+    alignas(R) std::byte target[sizeof(R)];
+    R* from = std::construct_at(reinterpret_cast<R*>(source), std::make_unique<int>(9));
+    R* to = relocate(from, reinterpret_cast<R*>(target));
+    EXPECT_EQ(*to->get<1>(), 9);
+    std::destroy_at(to);
+}
+
+TEST(NoExceptionsDeathTest, GetCallsHandlerAndAborts) {
+    const BadVariantAccessHandler previous = set_bad_variant_access_handler(report_access_error);
+    V v(1);
+    EXPECT_DEATH(v.get<std::string>(), "bad access: wrong alternative");
+    EXPECT_DEATH(v.try_get<2>().value(), "bad access: wrong alternative");
+    set_bad_variant_access_handler(previous);
+}
+
+TEST(NoExceptionsDeathTest, VisitOfValuelessCallsHandlerAndAborts) {
+    const BadVariantAccessHandler previous = set_bad_variant_access_handler(report_access_error);
+    Variant<MaybeThrowingMove, int> source;
+    Variant<MaybeThrowingMove, int> target(std::move(source));
+    EXPECT_DEATH(source.visit([](const auto&) {}), "bad access: valueless");
+    set_bad_variant_access_handler(previous);
+}
+
+TEST(NoExceptionsDeathTest, AbortsWithoutHandler) {
+    const BadVariantAccessHandler previous = set_bad_variant_access_handler(nullptr);
+    V v(1);
+    EXPECT_DEATH(v.get<1>(), "");
+    set_bad_variant_access_handler(previous);
+}
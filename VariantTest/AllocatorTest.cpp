@@ -0,0 +1,103 @@
+#include "pch.h"
+#include "Variant.hpp"
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+    using Value = Variant<std::pmr::string, std::pmr::vector<int>, int>;
+
+    constexpr const char* long_text = "a string long enough to need an allocation";
+
+    // Makes every allocation from the default resource throw while alive.
+    struct NoDefaultResource {
+        std::pmr::memory_resource* previous =
+            std::pmr::set_default_resource(std::pmr::null_memory_resource());
+
+        ~NoDefaultResource() {
+            std::pmr::set_default_resource(previous);
+        }
+    };
+
+    template<typename VariantType>
+    concept HasAllocator = requires(const VariantType& variant) { variant.get_allocator(); };
+}
+
+TEST(AllocatorTest, TakesTheAllocatorOfItsAlternatives) {
+    static_assert(std::is_same_v<Value::allocator_type, std::pmr::polymorphic_allocator<char>>);
+    static_assert(std::uses_allocator_v<Value, std::pmr::polymorphic_allocator<char>>);
+    static_assert(!std::uses_allocator_v<Variant<int, float>, std::allocator<int>>);
+    static_assert(HasAllocator<Value>);
+    static_assert(!HasAllocator<Variant<int, float>>);
+    static_assert(sizeof(Variant<std::string, int>) == sizeof(Variant<std::string, int, float>));
+}
+
+TEST(AllocatorTest, BuildsEveryAlternativeInTheArena) {
+    std::pmr::monotonic_buffer_resource arena;
+    std::pmr::monotonic_buffer_resource other_arena;
+    const NoDefaultResource no_default;
+
+    Value value(std::allocator_arg, &arena, std::in_place_type<std::pmr::string>, long_text);
+    EXPECT_EQ(value.get_allocator().resource(), &arena);
+    EXPECT_EQ(value.get<std::pmr::string>().get_allocator().resource(), &arena);
+
+    value.emplace<std::pmr::vector<int>>({ 1, 2, 3 });
+    EXPECT_EQ(value.get<std::pmr::vector<int>>().get_allocator().resource(), &arena);
+    EXPECT_EQ(value.get<std::pmr::vector<int>>().size(), 3);
+
+    value = 4;
+    value = std::pmr::string(long_text, &arena);
+    EXPECT_EQ(value.get<std::pmr::string>().get_allocator().resource(), &arena);
+
+    Value other(std::allocator_arg, &other_arena, std::in_place_index<1>, 3, 7);
+    value = other;
+    EXPECT_EQ(value.get<std::pmr::vector<int>>().get_allocator().resource(), &arena);
+    value = std::move(other);
+    EXPECT_EQ(value.get<std::pmr::vector<int>>().get_allocator().resource(), &arena);
+
+    Value copy(std::allocator_arg, &other_arena, value);
+    EXPECT_EQ(copy.get<std::pmr::vector<int>>().get_allocator().resource(), &other_arena);
+    EXPECT_EQ(copy, value);
+}
+
+TEST(AllocatorTest, CopyWithoutAnAllocatorUsesTheDefaultResource) {
+    std::pmr::monotonic_buffer_resource arena;
+    Value value(std::allocator_arg, &arena, std::pmr::string(long_text));
+
+    Value copy = value;
+    EXPECT_EQ(copy.get_allocator().resource(), std::pmr::get_default_resource());
+    EXPECT_EQ(copy.get<std::pmr::string>().get_allocator().resource(), std::pmr::get_default_resource());
+
+    Value moved = std::move(value);
+    EXPECT_EQ(moved.get_allocator().resource(), &arena);
+    EXPECT_EQ(moved.get<std::pmr::string>().get_allocator().resource(), &arena);
+}
+
+TEST(AllocatorTest, PmrContainersPassTheirResourceDown) {
+    std::pmr::monotonic_buffer_resource arena;
+    const NoDefaultResource no_default;
+
+    std::pmr::vector<Value> values(&arena);
+    for (int i = 0; i < 20; ++i) {
+        values.emplace_back(std::in_place_type<std::pmr::string>, long_text);
+        values.emplace_back(i);
+    }
+    for (const Value& value : values) {
+        EXPECT_EQ(value.get_allocator().resource(), &arena);
+    }
+    EXPECT_EQ(values[38].get<std::pmr::string>().get_allocator().resource(), &arena);
+}
+
+TEST(AllocatorTest, SwapKeepsEachAllocator) {
+    std::pmr::monotonic_buffer_resource first_arena;
+    std::pmr::monotonic_buffer_resource second_arena;
+    Value first(std::allocator_arg, &first_arena, std::pmr::string("first, long enough to allocate"));
+    Value second(std::allocator_arg, &second_arena, std::pmr::string("second, long enough to allocate"));
+
+    first.swap(second);
+    EXPECT_EQ(first.get<std::pmr::string>(), "second, long enough to allocate");
+    EXPECT_EQ(first.get<std::pmr::string>().get_allocator().resource(), &first_arena);
+    EXPECT_EQ(second.get<std::pmr::string>().get_allocator().resource(), &second_arena);
+}
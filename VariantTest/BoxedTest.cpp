@@ -0,0 +1,196 @@
+#include "pch.h"
+#include "Variant.hpp"
+#include <array>
+#include <cstdint>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+    struct Large {
+        static inline int alive = 0;
+
+        std::array<std::uint64_t, 64> payload{};
+
+        Large() { ++alive; }
+        explicit Large(std::uint64_t first) { payload[0] = first; ++alive; }
+        Large(const Large& other) : payload(other.payload) { ++alive; }
+        ~Large() { --alive; }
+        Large& operator=(const Large&) = default;
+
+        bool operator==(const Large& other) const { return payload == other.payload; }
+    };
+
+    struct ThrowsOnInt {
+        ThrowsOnInt() = default;
+        explicit ThrowsOnInt(int) {
+            throw std::runtime_error("construct fail");
+        }
+        // Potentially throwing: unboxed, it makes the Variant valueless-capable.
+        ThrowsOnInt(ThrowsOnInt&&) {}
+    };
+
+    // Copy-only, so it is moved by a potentially throwing copy.
+    struct Counted {
+        static inline int alive = 0;
+
+        Counted() { ++alive; }
+        Counted(const Counted&) { ++alive; }
+        ~Counted() { --alive; }
+        Counted& operator=(const Counted&) = default;
+    };
+
+    using Message = Variant<int, std::string, Boxed<Large>>;
+}
+
+TEST(BoxedTest, KeepsTheVariantSmall) {
+    static_assert(sizeof(Message) == sizeof(Variant<int, std::string, Large*>));
+    static_assert(sizeof(Message) < sizeof(Large));
+    // Moving a box out leaves the Variant valueless.
+    static_assert(!Message::never_valueless);
+    static_assert(std::is_nothrow_move_constructible_v<Message>);
+    static_assert(!Variant<int, ThrowsOnInt>::never_valueless);
+    static_assert(meta_functions::is_trivially_relocatable_v<Variant<int, Boxed<Large>>>);
+}
+
+TEST(BoxedTest, AccessSeesTheBoxedType) {
+    Large::alive = 0;
+    {
+        Message message(std::in_place_type<Large>, 7u);
+        EXPECT_EQ(message.index(), 2);
+        EXPECT_TRUE(message.holds_alternative<Large>());
+        EXPECT_EQ(message.get<Large>().payload[0], 7u);
+        EXPECT_EQ(message.get<2>().payload[0], 7u);
+        ASSERT_NE(message.get_if<Large>(), nullptr);
+        EXPECT_EQ(message.get_if<std::string>(), nullptr);
+
+        Large& large = message.emplace<Large>(9u);
+        EXPECT_EQ(&large, &message.get<Large>());
+        EXPECT_EQ(Large::alive, 1);
+
+        message.get<Large>().payload[1] = 3;
+        EXPECT_EQ(message.visit([](const auto& value) -> std::uint64_t {
+            if constexpr (std::is_same_v<std::remove_cvref_t<decltype(value)>, Large>) {
+                return value.payload[0] + value.payload[1];
+            }
+            else {
+                return 0;
+            }
+        }), 12u);
+
+        message = 5;
+        EXPECT_EQ(Large::alive, 0);
+        message = Large(4);
+        EXPECT_EQ(message.get<Large>().payload[0], 4u);
+    }
+    EXPECT_EQ(Large::alive, 0);
+}
+
+TEST(BoxedTest, CopiesTheValueAndMovesThePointer) {
+    Large::alive = 0;
+    {
+        Message message(Large(1));
+        Message copy = message;
+        EXPECT_EQ(Large::alive, 2);
+        EXPECT_EQ(copy, message);
+        EXPECT_NE(&copy.get<Large>(), &message.get<Large>());
+
+        const Large* address = &message.get<Large>();
+        Message moved = std::move(message);
+        EXPECT_EQ(&moved.get<Large>(), address);
+        EXPECT_EQ(Large::alive, 2);
+
+        message = copy;
+        EXPECT_EQ(message.get<Large>().payload[0], 1u);
+        EXPECT_EQ(Large::alive, 3);
+
+        Message text(std::string("text"));
+        text.swap(moved);
+        EXPECT_EQ(text.get<Large>().payload[0], 1u);
+        EXPECT_EQ(moved.get<std::string>(), "text");
+    }
+    EXPECT_EQ(Large::alive, 0);
+}
+
+TEST(BoxedTest, MovedFromVariantIsValueless) {
+    Large::alive = 0;
+    {
+        Message message(Large(2));
+        Message moved = std::move(message);
+        EXPECT_TRUE(message.valueless_by_exception());
+        EXPECT_EQ(message.index(), Message::npos);
+        EXPECT_THROW(message.get<Large>(), std::bad_variant_access);
+        EXPECT_THROW(message.visit([](const auto&) {}), std::bad_variant_access);
+        EXPECT_NE(message, moved);
+
+        Message copy = message;
+        EXPECT_TRUE(copy.valueless_by_exception());
+
+        Message assigned(5);
+        assigned = std::move(moved);
+        EXPECT_TRUE(moved.valueless_by_exception());
+        EXPECT_EQ(assigned.get<Large>().payload[0], 2u);
+        EXPECT_EQ(Large::alive, 1);
+
+        message = assigned;
+        EXPECT_EQ(message.get<Large>().payload[0], 2u);
+        EXPECT_EQ(Large::alive, 2);
+    }
+    EXPECT_EQ(Large::alive, 0);
+}
+
+TEST(BoxedTest, MovedFromVariantDestroysItsAlternative) {
+    Counted::alive = 0;
+    {
+        using Record = Variant<Counted, Boxed<Large>>;
+        static_assert(!Record::never_valueless);
+
+        Record source(std::in_place_type<Counted>);
+        Record moved = std::move(source);
+        EXPECT_TRUE(source.valueless_by_exception());
+        EXPECT_EQ(Counted::alive, 1);
+
+        Record assigned(std::in_place_type<Large>);
+        assigned = std::move(moved);
+        EXPECT_TRUE(moved.valueless_by_exception());
+        EXPECT_EQ(Counted::alive, 1);
+
+        using ArenaRecord = Variant<std::pmr::string, Counted, Boxed<Large>>;
+        std::pmr::monotonic_buffer_resource arena;
+        ArenaRecord original(std::in_place_type<Counted>);
+        ArenaRecord rebound(std::allocator_arg, &arena, std::move(original));
+        EXPECT_TRUE(original.valueless_by_exception());
+        EXPECT_EQ(Counted::alive, 2);
+    }
+    EXPECT_EQ(Counted::alive, 0);
+}
+
+TEST(BoxedTest, ThrowingEmplaceKeepsTheOldValue) {
+    Variant<int, Boxed<ThrowsOnInt>> v(3);
+    EXPECT_THROW(v.emplace<ThrowsOnInt>(1), std::runtime_error);
+    EXPECT_FALSE(v.valueless_by_exception());
+    EXPECT_EQ(v.get<int>(), 3);
+}
+
+TEST(BoxedTest, BlocksFreedOnAnotherThreadAreReused) {
+    Large::alive = 0;
+    std::vector<Message> queue;
+    for (int round = 0; round < 8; ++round) {
+        for (int i = 0; i < 100; ++i) {
+            queue.emplace_back(std::in_place_type<Large>, static_cast<std::uint64_t>(i));
+        }
+        std::thread consumer([&queue] {
+            std::uint64_t sum = 0;
+            for (const Message& message : queue) {
+                sum += message.get<Large>().payload[0];
+            }
+            EXPECT_EQ(sum, 4950u);
+            queue.clear();
+        });
+        consumer.join();
+    }
+    EXPECT_EQ(Large::alive, 0);
+}
@@ -1,5 +1,7 @@
 #include "pch.h"
 #include "Variant.hpp"
+#include <string>
+#include <utility>
 
 
 TEST(ConstexprTest_Helpers, IndexAndValuelessAreConstexpr) {
@@ -186,3 +188,136 @@ TEST(ConstexprTest_Getters, GetIfByIndexIsConstexpr) {
     static_assert(v.get_if<1>() != nullptr);
     static_assert(v.get_if<0>() == nullptr);
 }
+
+
+TEST(ConstexprTest_Triviality, TrivialAlternativesGiveTrivialVariant) {
+    using V = Variant<int, double, char>;
+    static_assert(std::is_trivially_copyable_v<V>);
+    static_assert(std::is_trivially_destructible_v<V>);
+    static_assert(std::is_trivially_copy_constructible_v<V>);
+    static_assert(std::is_trivially_move_constructible_v<V>);
+    static_assert(std::is_trivially_copy_assignable_v<V>);
+    static_assert(std::is_trivially_move_assignable_v<V>);
+    static_assert(std::is_trivially_destructible_v<VariadicUnion<int, double, char>>);
+}
+
+TEST(ConstexprTest_Triviality, NonTrivialAlternativeDisablesTriviality) {
+    using V = Variant<int, std::string>;
+    static_assert(!std::is_trivially_copyable_v<V>);
+    static_assert(!std::is_trivially_destructible_v<V>);
+    static_assert(!std::is_trivially_copy_constructible_v<V>);
+    static_assert(!std::is_trivially_move_constructible_v<V>);
+    static_assert(std::is_copy_constructible_v<V>);
+    static_assert(std::is_move_constructible_v<V>);
+    static_assert(!std::is_trivially_destructible_v<VariadicUnion<int, std::string>>);
+}
+
+TEST(ConstexprTest_Triviality, TrivialCopyIsConstexpr) {
+    constexpr Variant<int, double> original(2.5);
+    constexpr Variant<int, double> copy = original;
+    static_assert(copy.index() == 1);
+    static_assert(copy.get<double>() == 2.5);
+}
+
+TEST(ConstexprTest_Triviality, TrivialMoveKeepsSourceValue) {
+    Variant<int, double> original(7);
+    Variant<int, double> moved = std::move(original);
+    EXPECT_EQ(moved.get<int>(), 7);
+    EXPECT_EQ(original.get<int>(), 7);
+}
+
+
+namespace {
+    template<std::size_t I>
+    struct Numbered {
+        int value = static_cast<int>(I);
+    };
+
+    template<typename Sequence>
+    struct _Numbered_pack;
+
+    template<std::size_t... Is>
+    struct _Numbered_pack<std::index_sequence<Is...>> {
+        using variant = Variant<Numbered<Is>...>;
+    };
+
+    // More alternatives than variant_detail::_Flat_storage_threshold, so the
+    // Variant keeps them in FlatStorage.
+    using WideVariant = _Numbered_pack<std::make_index_sequence<17>>::variant;
+
+    constexpr int reassign_wide() {
+        WideVariant v;
+        v.emplace<9>(Numbered<9>{ 90 });
+        WideVariant copy = v;
+        v = WideVariant(std::in_place_index<16>);
+        return copy.get<9>().value + v.get<16>().value;
+    }
+}
+
+TEST(ConstexprTest_Storage, FlatStorageIsConstexpr) {
+    constexpr WideVariant v(std::in_place_index<16>, Numbered<16>{ 42 });
+    static_assert(v.index() == 16);
+    static_assert(v.get<Numbered<16>>().value == 42);
+    static_assert(reassign_wide() == 106);
+}
+
+namespace {
+    struct Empty {};
+
+    constexpr bool reassign_niche_eligible() {
+        Variant<bool, Empty> v(Empty{});
+        Variant<bool, Empty> copy = v;
+        v = true;
+        return copy.holds_alternative<Empty>() && v.get<bool>();
+    }
+}
+
+TEST(ConstexprTest_Storage, NicheEligiblePackIsConstexprUnlessOptedIn) {
+    static_assert(variant_layout_v<Variant<bool, Empty>>.kind == VariantLayoutKind::tagged);
+    constexpr Variant<bool, Empty> v(true);
+    static_assert(v.index() == 0);
+    static_assert(v.get<bool>());
+    static_assert(reassign_niche_eligible());
+}
+
+namespace {
+    // Shorter than the double it shares the storage with, so an opted-in
+    // pack would keep the index in the bytes behind it.
+    struct S9 {
+        char c[9];
+    };
+
+    constexpr int reassign_packable() {
+        Variant<S9, double> v(S9{ { 'a', 'b' } });
+        Variant<S9, double> copy = v;
+        v = 2.0;
+        return copy.get<S9>().c[1] + static_cast<int>(v.get<double>());
+    }
+}
+
+TEST(ConstexprTest_Storage, PackablePackIsConstexprUnlessOptedIn) {
+    static_assert(variant_layout_v<Variant<S9, double>>.kind == VariantLayoutKind::tagged);
+    constexpr Variant<S9, double> v(S9{ { 'x' } });
+    static_assert(v.index() == 0);
+    static_assert(v.get<S9>().c[0] == 'x');
+    static_assert(reassign_packable() == 'b' + 2);
+}
+
+namespace {
+    using Nested = Variant<Variant<int, float>, int>;
+
+    constexpr float reassign_nested() {
+        Nested v(std::in_place_index<1>, 5);
+        Nested copy = v;
+        v.emplace<0>(2.5f);
+        return static_cast<float>(copy.get<1>()) + v.get<0>().get<float>();
+    }
+}
+
+TEST(ConstexprTest_Storage, NestedVariantIsConstexprUnlessOptedIn) {
+    static_assert(variant_layout_v<Nested>.kind == VariantLayoutKind::tagged);
+    constexpr Nested v(Variant<int, float>(1.5f));
+    static_assert(v.index() == 0);
+    static_assert(v.get<0>().get<float>() == 1.5f);
+    static_assert(reassign_nested() == 7.5f);
+}
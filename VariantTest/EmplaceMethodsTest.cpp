@@ -27,6 +27,7 @@ namespace {
         ThrowingType(std::initializer_list<int>, int) {
             if (valueless_trigger) throw std::runtime_error("fail");
         }
+        ThrowingType(ThrowingType&&) {}
         static inline bool valueless_trigger = false;
     };
 
@@ -40,6 +41,10 @@ namespace {
     };
 }
 
+// The BecomesValuelessIf_ tests below rely on ThrowingType's move being allowed
+// to throw; a nothrow move would make the Variant keep its old value instead.
+static_assert(!Variant<ThrowingType>::never_valueless);
+
 TEST(EmplaceTest_DirectEmplace, FailsIf_TypeIsNotConstructibleFromArgs) {
     Variant<NoEmplace> v;
     // v.emplace<int>(123);
@@ -1,7 +1,17 @@
 #include "pch.h"
 #include "Variant.hpp"
+#include <stdexcept>
 #include <string>
 
+namespace {
+    struct ThrowingType {
+        ThrowingType() = default;
+        ThrowingType(int) {
+            throw std::runtime_error("construct fail");
+        }
+        ThrowingType(ThrowingType&&) {}
+    };
+}
 
 TEST(GetTest, GetByTypeLvalue) {
     Variant<int, std::string> v(std::in_place_type<std::string>, "abc");
@@ -81,3 +91,67 @@ TEST(Get_ifTest, GetIfByIndexConstLvalue) {
     ASSERT_NE(ptr, nullptr);
     EXPECT_EQ(*ptr, "constindex");
 }
+
+TEST(TryGetTest, ReturnsActiveAlternative) {
+    Variant<int, std::string> v(std::in_place_type<std::string>, "abc");
+    auto result = v.try_get<std::string>();
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(*result, "abc");
+    result->append("d");
+    EXPECT_EQ(v.get<1>(), "abcd");
+}
+
+TEST(TryGetTest, ReportsWrongAlternative) {
+    const Variant<int, std::string> v(42);
+    auto result = v.try_get<1>();
+    EXPECT_FALSE(result);
+    EXPECT_EQ(result.get(), nullptr);
+    EXPECT_EQ(result.error(), VariantAccessError::wrong_alternative);
+    EXPECT_THROW(result.value(), std::bad_variant_access);
+}
+
+TEST(TryGetTest, ReportsValueless) {
+    Variant<int, ThrowingType> v;
+    try { v.emplace<ThrowingType>(1); }
+    catch (...) {}
+    auto result = v.try_get<int>();
+    EXPECT_FALSE(result.has_value());
+    EXPECT_EQ(result.error(), VariantAccessError::valueless);
+}
+
+TEST(TryGetTest, IsConstexpr) {
+    constexpr Variant<int, double> v(2.5);
+    static_assert(*v.try_get<double>() == 2.5);
+    static_assert(!v.try_get<0>());
+}
+
+TEST(GetPolicyTest, UncheckedReturnsActiveAlternative) {
+    Variant<int, std::string> v(std::in_place_type<std::string>, "abc");
+    EXPECT_EQ((v.get<std::string, VariantAccessPolicy::unchecked>()), "abc");
+    EXPECT_EQ((v.get<1, VariantAccessPolicy::unchecked>()), "abc");
+    std::string moved = std::move(v).get<1, VariantAccessPolicy::unchecked>();
+    EXPECT_EQ(moved, "abc");
+}
+
+TEST(GetPolicyTest, AssertingReturnsActiveAlternative) {
+    const Variant<int, double> v(2.5);
+    EXPECT_EQ((v.get<double, VariantAccessPolicy::asserting>()), 2.5);
+    EXPECT_EQ((v.get<1, VariantAccessPolicy::asserting>()), 2.5);
+}
+
+TEST(GetPolicyTest, AssertingAbortsOnWrongAlternativeInDebug) {
+    Variant<int, double> v(1);
+    EXPECT_DEBUG_DEATH((void)(v.get<1, VariantAccessPolicy::asserting>()), "not active");
+}
+
+TEST(GetPolicyTest, CheckedIsTheDefault) {
+    Variant<int, double> v(1);
+    EXPECT_THROW((v.get<1, VariantAccessPolicy::checked>()), std::bad_variant_access);
+    EXPECT_THROW(v.get<1>(), std::bad_variant_access);
+}
+
+TEST(GetPolicyTest, IsConstexpr) {
+    constexpr Variant<int, double> v(2.5);
+    static_assert(v.get<1, VariantAccessPolicy::unchecked>() == 2.5);
+    static_assert(v.get<double, VariantAccessPolicy::asserting>() == 2.5);
+}
@@ -0,0 +1,146 @@
+#include "pch.h"
+#include "NanBoxedVariant.hpp"
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <variant>
+
+namespace {
+    struct Object {
+        int id;
+    };
+
+    enum class Color : std::uint8_t { red, green, blue };
+
+    using Value = NanBoxedVariant<double, std::int32_t, bool, Object*>;
+
+    template<typename... Types>
+    concept Boxable = requires { sizeof(NanBoxedVariant<Types...>); };
+}
+
+TEST(NanBoxedVariantTest, IsASingleWord) {
+    static_assert(sizeof(Value) == 8);
+    static_assert(std::is_trivially_copyable_v<Value>);
+    static_assert(Value::alternatives_count == 4);
+}
+
+TEST(NanBoxedVariantTest, RejectsAlternativesThatDoNotFit) {
+    static_assert(Boxable<double, float, Color, std::uint16_t, char>);
+    static_assert(!Boxable<std::int32_t, bool>);
+    static_assert(!Boxable<double, std::int64_t>);
+    static_assert(!Boxable<double, Object>);
+    static_assert(!Boxable<double, int, unsigned, short, char, bool, float, Color>);
+}
+
+TEST(NanBoxedVariantTest, DefaultHoldsZeroOfFirstAlternative) {
+    Value value;
+    EXPECT_EQ(value.index(), 0);
+    EXPECT_EQ(value.get<double>(), 0.0);
+}
+
+TEST(NanBoxedVariantTest, KeepsEveryAlternative) {
+    Object object{ 3 };
+
+    Value value(2.5);
+    EXPECT_EQ(value.index(), 0);
+    EXPECT_DOUBLE_EQ(value.get<double>(), 2.5);
+
+    value = std::int32_t(-7);
+    EXPECT_EQ(value.index(), 1);
+    EXPECT_EQ(value.get<std::int32_t>(), -7);
+
+    value = true;
+    EXPECT_TRUE(value.holds_alternative<bool>());
+    EXPECT_TRUE(value.get<2>());
+
+    EXPECT_EQ(value.emplace<Object*>(&object), &object);
+    EXPECT_EQ(value.index(), 3);
+    EXPECT_EQ(value.get<Object*>()->id, 3);
+
+    value.emplace<3>(nullptr);
+    EXPECT_EQ(value.get<Object*>(), nullptr);
+}
+
+TEST(NanBoxedVariantTest, KeepsSpecialDoubles) {
+    const double infinity = std::numeric_limits<double>::infinity();
+    EXPECT_EQ(Value(-infinity).get<double>(), -infinity);
+    EXPECT_EQ(Value(infinity).get<double>(), infinity);
+    EXPECT_TRUE(std::signbit(Value(-0.0).get<double>()));
+
+    // Any NaN, including one whose bits would look like a boxed value.
+    const double boxed_looking = std::bit_cast<double>(std::uint64_t(0xFFFA000000000001));
+    for (double nan : { std::numeric_limits<double>::quiet_NaN(), -std::numeric_limits<double>::quiet_NaN(),
+                        std::numeric_limits<double>::signaling_NaN(), boxed_looking }) {
+        Value value(nan);
+        EXPECT_EQ(value.index(), 0);
+        EXPECT_TRUE(std::isnan(value.get<double>()));
+    }
+}
+
+TEST(NanBoxedVariantTest, GetIfReturnsAnOptional) {
+    Value value(std::int32_t(42));
+    EXPECT_FALSE(value.get_if<double>().has_value());
+    ASSERT_TRUE(value.get_if<std::int32_t>().has_value());
+    EXPECT_EQ(*value.get_if<1>(), 42);
+}
+
+TEST(NanBoxedVariantTest, WrongAlternativeFailsLikeVariant) {
+    Value value(1.0);
+    EXPECT_THROW(value.get<bool>(), std::bad_variant_access);
+    EXPECT_EQ((value.get<double, VariantAccessPolicy::unchecked>()), 1.0);
+}
+
+TEST(NanBoxedVariantTest, VisitsTheActiveAlternative) {
+    const auto as_double = [](auto value) -> double {
+        if constexpr (std::is_pointer_v<decltype(value)>) {
+            return value->id;
+        }
+        else {
+            return static_cast<double>(value);
+        }
+    };
+
+    Object object{ 9 };
+    EXPECT_DOUBLE_EQ(Value(0.5).visit(as_double), 0.5);
+    EXPECT_DOUBLE_EQ(Value(std::int32_t(-3)).visit(as_double), -3.0);
+    EXPECT_DOUBLE_EQ(Value(true).visit(as_double), 1.0);
+    EXPECT_DOUBLE_EQ(Value(&object).visit(as_double), 9.0);
+}
+
+TEST(NanBoxedVariantTest, FreeFunctionsMatchTheMembers) {
+    Object object{ 4 };
+    Value value(&object);
+    EXPECT_EQ(get<Object*>(value), &object);
+    EXPECT_EQ(get<3>(value), &object);
+    EXPECT_THROW(get<double>(value), std::bad_variant_access);
+    EXPECT_FALSE(get_if<bool>(value).has_value());
+    ASSERT_TRUE(get_if<3>(value).has_value());
+    EXPECT_EQ(*get_if<3>(value), &object);
+
+    const int id = visit([](auto alternative) -> int {
+        if constexpr (std::is_pointer_v<decltype(alternative)>) {
+            return alternative->id;
+        }
+        else {
+            return 0;
+        }
+    }, value);
+    EXPECT_EQ(id, 4);
+
+    // Overloads for Variant are visible too and do not interfere.
+    EXPECT_EQ(visit([](auto alternative) { return sizeof(alternative); }, Variant<char, int>(1)), sizeof(int));
+}
+
+TEST(NanBoxedVariantTest, ComparesAlternatives) {
+    EXPECT_EQ(Value(0.0), Value(-0.0));
+    EXPECT_NE(Value(std::numeric_limits<double>::quiet_NaN()), Value(std::numeric_limits<double>::quiet_NaN()));
+    EXPECT_NE(Value(1.0), Value(std::int32_t(1)));
+    EXPECT_EQ(Value(std::int32_t(1)), Value(std::int32_t(1)));
+
+    Value a(true);
+    Value b(2.0);
+    a.swap(b);
+    EXPECT_EQ(a.get<double>(), 2.0);
+    EXPECT_TRUE(b.get<bool>());
+}
@@ -0,0 +1,136 @@
+#include "pch.h"
+#include "Variant.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace {
+    enum class Kind : std::uint8_t { file, socket, pipe };
+
+    struct Handle {
+        std::uint32_t id;
+        Kind kind;
+
+        bool operator==(const Handle&) const = default;
+    };
+
+    struct Counted {
+        static inline int alive = 0;
+
+        Counted() { ++alive; }
+        Counted(const Counted&) { ++alive; }
+        Counted(Counted&&) noexcept { ++alive; }
+        ~Counted() { --alive; }
+        Counted& operator=(const Counted&) = default;
+        Counted& operator=(Counted&&) noexcept = default;
+
+        bool operator==(const Counted&) const { return true; }
+    };
+
+    using HandleVariant = Variant<Handle, bool, Kind, std::uint16_t>;
+}
+
+template<>
+struct meta_functions::niche_traits<Handle>
+    : meta_functions::value_niche_traits<Kind, Kind::pipe, offsetof(Handle, kind)> {};
+
+template<> struct meta_functions::enable_compact_layout<Handle, bool, Kind, std::uint16_t> : std::true_type {};
+template<> struct meta_functions::enable_compact_layout<bool, Counted> : std::true_type {};
+template<> struct meta_functions::enable_compact_layout<Counted, int*> : std::true_type {};
+template<> struct meta_functions::enable_compact_layout<int*, Counted> : std::true_type {};
+template<> struct meta_functions::enable_compact_layout<Variant<int, float>, int> : std::true_type {};
+
+static_assert(sizeof(HandleVariant) == sizeof(Handle));
+static_assert(sizeof(Variant<int*, Counted>) == sizeof(int*));
+
+TEST(NicheLayoutTest, TracksEveryAlternative) {
+    HandleVariant v(Handle{ 7, Kind::socket });
+    EXPECT_EQ(v.index(), 0);
+    EXPECT_EQ(v.get<Handle>(), (Handle{ 7, Kind::socket }));
+
+    v = true;
+    EXPECT_EQ(v.index(), 1);
+    EXPECT_TRUE(v.get<bool>());
+
+    v = Kind::pipe;
+    EXPECT_EQ(v.index(), 2);
+    EXPECT_EQ(v.get<Kind>(), Kind::pipe);
+
+    v = std::uint16_t(0xFFFF);
+    EXPECT_EQ(v.index(), 3);
+    EXPECT_EQ(v.get<std::uint16_t>(), 0xFFFF);
+    EXPECT_TRUE(v.holds_alternative<std::uint16_t>());
+    EXPECT_EQ(v.get_if<Handle>(), nullptr);
+
+    v.emplace<Handle>(Handle{ 9, Kind::file });
+    EXPECT_EQ(v.index(), 0);
+    EXPECT_EQ(v.get<Handle>(), (Handle{ 9, Kind::file }));
+}
+
+TEST(NicheLayoutTest, DefaultConstructsTheFirstAlternative) {
+    Variant<bool, Counted> v;
+    EXPECT_EQ(v.index(), 0);
+    EXPECT_FALSE(v.get<bool>());
+
+    Variant<Counted, int*> w;
+    EXPECT_EQ(w.index(), 0);
+}
+
+TEST(NicheLayoutTest, CopyMoveAndSwapKeepTheIndex) {
+    HandleVariant a(Kind::socket);
+    HandleVariant b(Handle{ 1, Kind::file });
+
+    HandleVariant copy = a;
+    EXPECT_EQ(copy.index(), 2);
+    EXPECT_EQ(copy, a);
+
+    HandleVariant moved = std::move(b);
+    EXPECT_EQ(moved.index(), 0);
+
+    a.swap(moved);
+    EXPECT_EQ(a.get<Handle>(), (Handle{ 1, Kind::file }));
+    EXPECT_EQ(moved.get<Kind>(), Kind::socket);
+    EXPECT_NE(a, moved);
+}
+
+TEST(NicheLayoutTest, DestroysTheActiveAlternative) {
+    Counted::alive = 0;
+    {
+        Variant<int*, Counted> v(std::in_place_type<Counted>);
+        EXPECT_EQ(v.index(), 1);
+        EXPECT_EQ(Counted::alive, 1);
+
+        Variant<int*, Counted> copy = v;
+        EXPECT_EQ(Counted::alive, 2);
+
+        v = static_cast<int*>(nullptr);
+        EXPECT_EQ(v.index(), 0);
+        EXPECT_EQ(v.get<int*>(), nullptr);
+        EXPECT_EQ(Counted::alive, 1);
+    }
+    EXPECT_EQ(Counted::alive, 0);
+}
+
+TEST(NicheLayoutTest, VisitReachesTheActiveAlternative) {
+    int value = 42;
+    Variant<int*, Counted> v(&value);
+    EXPECT_EQ(v.visit([](const auto& alternative) {
+        if constexpr (std::is_same_v<std::remove_cvref_t<decltype(alternative)>, int*>) {
+            return *alternative;
+        }
+        else {
+            return 0;
+        }
+    }), 42);
+}
+
+TEST(NicheLayoutTest, NestedVariantKeepsBothIndices) {
+    Variant<Variant<int, float>, int> v(std::in_place_index<1>, 5);
+    EXPECT_EQ(v.index(), 1);
+    EXPECT_EQ(v.get<1>(), 5);
+
+    v.emplace<0>(2.5f);
+    EXPECT_EQ(v.index(), 0);
+    EXPECT_EQ(v.get<0>().index(), 1);
+    EXPECT_FLOAT_EQ(v.get<0>().get<float>(), 2.5f);
+}
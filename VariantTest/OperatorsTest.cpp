@@ -1,5 +1,6 @@
 #include "pch.h"
 #include "Variant.hpp"
+#include <string>
 
 namespace {
     struct NoOperator {
@@ -76,6 +77,20 @@ namespace {
             compared = false;
         }
     };
+
+    struct NotComparable {
+        std::string value;
+    };
+
+    template<std::size_t I>
+    struct Wide {
+        std::string value = std::to_string(I);
+
+        bool operator==(const Wide&) const = default;
+    };
+
+    using WideVariant = Variant<Wide<0>, Wide<1>, Wide<2>, Wide<3>, Wide<4>, Wide<5>,
+        Wide<6>, Wide<7>, Wide<8>, Wide<9>, Wide<10>, Wide<11>>;
 }
 
 
@@ -200,6 +215,23 @@ TEST(OperatorsTest_CopyAssignment, DestroysPreviousTypeAnd_CopiAssignment) {
 }
 
 
+TEST(OperatorsTest_CopyAssignment, DoesNotCompareOperands) {
+    Tracker::reset();
+    Variant<Tracker, int> v1(Tracker(1)), v2(Tracker(2));
+    v1 = v2;
+    v1 = v1;
+    EXPECT_FALSE(Tracker::compared);
+    EXPECT_TRUE(Tracker::assignCopied);
+}
+
+TEST(OperatorsTest_CopyAssignment, WorksFor_NonComparableTypes) {
+    Variant<NotComparable, int> v1(NotComparable{ "abc" }), v2(1);
+    v2 = v1;
+    EXPECT_EQ(v2.get<NotComparable>().value, "abc");
+    v2 = v2;
+    EXPECT_EQ(v2.get<NotComparable>().value, "abc");
+}
+
 TEST(OperatorsTest_MoveAssignment, FailsIf_TypeIsNotMoveConstructible) {
     Variant<NoOperator> v1, v2;
     // v2 = std::move(v1);
@@ -254,11 +286,23 @@ TEST(OperatorsTest_MoveAssignment, DestroysPreviousTypeAnd_MoveAssignment) {
     Tracker::reset();
     Variant<Tracker, int> v1, v2(std::in_place_index<0>, 5);
     v1 = std::move(v2);
-    v2 = Variant<Tracker, int>();
     EXPECT_FALSE(Tracker::destroyed);
     EXPECT_TRUE(Tracker::assignMoved);
+    EXPECT_EQ(v1.index(), 0);
+
+    // Tracker is nothrow move constructible, so the source is never made
+    // valueless: it keeps its moved-from Tracker, which Tracker's move
+    // assignment leaves untouched. Assigning to it then move-assigns that
+    // Tracker rather than constructing a new one.
+    static_assert(Variant<Tracker, int>::never_valueless);
+    EXPECT_EQ(v2.index(), 0);
+    EXPECT_EQ(v2.get<Tracker>(), 5);
+    Tracker::reset();
+    v2 = Variant<Tracker, int>();
+    EXPECT_TRUE(Tracker::assignMoved);
+    EXPECT_FALSE(Tracker::moved);
     EXPECT_EQ(v2.index(), 0);
-    EXPECT_EQ(v2.get<Tracker>(), 0);
+    EXPECT_EQ(v2.get<Tracker>(), 5);
 }
 
 TEST(OperatorsTest_MoveAssignment, DestroysPreviousTypeWith_ValuelessObj) {
@@ -275,6 +319,22 @@ TEST(OperatorsTest_MoveAssignment, DestroysPreviousTypeWith_ValuelessObj) {
 }
 
 
+TEST(OperatorsTest_MoveAssignment, DoesNotCompareOperands) {
+    Tracker::reset();
+    Variant<Tracker, int> v1(Tracker(1)), v2(Tracker(2));
+    v1 = std::move(v2);
+    EXPECT_FALSE(Tracker::compared);
+    EXPECT_TRUE(Tracker::assignMoved);
+}
+
+TEST(OperatorsTest_MoveAssignment, SelfAssignment_KeepsNonTrivialValue) {
+    Variant<NotComparable, int> v(NotComparable{ "abc" });
+    Variant<NotComparable, int>& ref = v;
+    v = std::move(ref);
+    EXPECT_EQ(v.index(), 0);
+    EXPECT_EQ(v.get<NotComparable>().value, "abc");
+}
+
 TEST(OperatorsTest_ValueAssignment, FailsIf_TypeIsNotConstructible) {
     Variant<NoOperator> v;
     //v = NoOperator{};
@@ -345,4 +405,27 @@ TEST(OperatorsTest_ValueAssignment, DestroysPreviousTypeAnd_Construction) {
     EXPECT_FALSE(Tracker::assignCopied);
     EXPECT_TRUE(Tracker::copied);
     EXPECT_EQ(v.index(), 0);
+}
+
+TEST(OperatorsTest_LargePack, CopiesComparesAndAssigns_AnyAlternative) {
+    WideVariant v1(std::in_place_index<10>);
+    WideVariant v2(v1);
+    EXPECT_EQ(v2.index(), 10);
+    EXPECT_EQ(v2.get<10>().value, "10");
+    EXPECT_TRUE(v1 == v2);
+
+    v2.get<10>().value = "changed";
+    EXPECT_FALSE(v1 == v2);
+
+    WideVariant v3(std::in_place_index<3>);
+    v3 = v2;
+    EXPECT_EQ(v3.index(), 10);
+    EXPECT_EQ(v3.get<10>().value, "changed");
+
+    v3 = WideVariant(std::in_place_index<11>);
+    EXPECT_EQ(v3.get<11>().value, "11");
+
+    v1.swap(v3);
+    EXPECT_EQ(v1.index(), 11);
+    EXPECT_EQ(v3.get<10>().value, "10");
 }
\ No newline at end of file
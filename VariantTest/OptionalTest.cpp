@@ -0,0 +1,145 @@
+#include "pch.h"
+#include "Optional.hpp"
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace {
+    struct Empty {};
+
+    struct ThrowingType {
+        ThrowingType() = default;
+        ThrowingType(int) {
+            throw std::runtime_error("construct fail");
+        }
+        ThrowingType(ThrowingType&&) {}
+    };
+
+    struct Counted {
+        static inline int alive = 0;
+
+        int value = 0;
+
+        Counted(int v) : value(v) { ++alive; }
+        Counted(const Counted& other) : value(other.value) { ++alive; }
+        Counted(Counted&& other) noexcept : value(other.value) { ++alive; }
+        ~Counted() { --alive; }
+        Counted& operator=(const Counted&) = default;
+        Counted& operator=(Counted&&) noexcept = default;
+    };
+
+    struct ThrowsOnInt {
+        int value = 0;
+
+        ThrowsOnInt() = default;
+        explicit ThrowsOnInt(int) {
+            throw std::runtime_error("construct fail");
+        }
+        ThrowsOnInt(ThrowsOnInt&&) noexcept = default;
+    };
+
+    using Message = Variant<int, double, std::string>;
+}
+
+template<> struct meta_functions::enable_compact_layout<bool, Empty> : std::true_type {};
+
+TEST(OptionalTest, VariantKeepsItsSize) {
+    static_assert(sizeof(Optional<Message>) == sizeof(Message));
+    static_assert(sizeof(Optional<Variant<char, bool>>) == sizeof(Variant<char, bool>));
+    static_assert(sizeof(Optional<Variant<bool, Empty>>) == sizeof(bool));
+    static_assert(sizeof(Optional<bool>) == sizeof(bool));
+    static_assert(sizeof(Optional<int*>) == sizeof(int*));
+}
+
+TEST(OptionalTest, VariantLendsItsIndexWithoutOptingIn) {
+    static_assert(!meta_functions::enable_compact_layout_v<int, float>);
+    static_assert(sizeof(Optional<Variant<int, float>>) == sizeof(Variant<int, float>));
+    static_assert(variant_layout_v<Variant<int, float>>.kind == VariantLayoutKind::tagged);
+}
+
+TEST(OptionalTest, OtherTypesGetAFlag) {
+    static_assert(sizeof(Optional<int>) == sizeof(std::optional<int>));
+    // A throwing move could leave a half-built Variant's index behind.
+    static_assert(sizeof(Optional<Variant<int, ThrowingType>>) > sizeof(Variant<int, ThrowingType>));
+    static_assert(std::is_trivially_copyable_v<Optional<int>>);
+    static_assert(std::is_trivially_copyable_v<Optional<Variant<int, float>>>);
+}
+
+TEST(OptionalTest, StartsEmpty) {
+    Optional<Message> empty;
+    EXPECT_FALSE(empty.has_value());
+    EXPECT_FALSE(empty);
+
+    Optional<Message> null(std::nullopt);
+    EXPECT_FALSE(null.has_value());
+}
+
+TEST(OptionalTest, EmplaceAndReset) {
+    Optional<Message> message;
+    Message& value = message.emplace(std::in_place_type<std::string>, "payload");
+    EXPECT_TRUE(message.has_value());
+    EXPECT_EQ(value.get<std::string>(), "payload");
+    EXPECT_EQ(message->index(), 2);
+
+    message.emplace(1.5);
+    EXPECT_DOUBLE_EQ(message.value().get<double>(), 1.5);
+
+    message.reset();
+    EXPECT_FALSE(message.has_value());
+}
+
+TEST(OptionalTest, HoldsAValuelessVariant) {
+    static_assert(!Variant<int, ThrowingType>::never_valueless);
+    Optional<Variant<int, ThrowingType>> optional(std::in_place);
+    EXPECT_THROW(optional->emplace<ThrowingType>(1), std::runtime_error);
+    EXPECT_TRUE(optional->valueless_by_exception());
+    EXPECT_TRUE(optional.has_value());
+}
+
+TEST(OptionalTest, CopiesAndMoves) {
+    Optional<Message> source(Message(std::string("a string long enough to be allocated")));
+
+    Optional<Message> copy = source;
+    EXPECT_TRUE(copy.has_value());
+    EXPECT_EQ(copy->get<std::string>(), "a string long enough to be allocated");
+
+    Optional<Message> moved = std::move(copy);
+    EXPECT_EQ(moved->get<std::string>(), "a string long enough to be allocated");
+
+    Optional<Message> target;
+    target = moved;
+    EXPECT_EQ(target->get<std::string>(), "a string long enough to be allocated");
+
+    target = std::nullopt;
+    EXPECT_FALSE(target.has_value());
+
+    moved = target;
+    EXPECT_FALSE(moved.has_value());
+}
+
+TEST(OptionalTest, DestroysTheValue) {
+    Counted::alive = 0;
+    {
+        Optional<Variant<Counted, Empty>> optional(std::in_place, std::in_place_type<Counted>, 3);
+        EXPECT_EQ(Counted::alive, 1);
+
+        Optional<Variant<Counted, Empty>> copy = optional;
+        EXPECT_EQ(Counted::alive, 2);
+
+        optional.reset();
+        EXPECT_EQ(Counted::alive, 1);
+    }
+    EXPECT_EQ(Counted::alive, 0);
+}
+
+TEST(OptionalTest, ThrowingEmplaceLeavesItEmpty) {
+    Optional<Variant<ThrowsOnInt, bool>> optional(std::in_place);
+    EXPECT_THROW(optional.emplace(std::in_place_type<ThrowsOnInt>, 1), std::runtime_error);
+    EXPECT_FALSE(optional.has_value());
+}
+
+TEST(OptionalTest, ValueOfEmptyThrows) {
+    Optional<Message> empty;
+    EXPECT_THROW(empty.value(), std::bad_optional_access);
+}
@@ -0,0 +1,141 @@
+#include "pch.h"
+#include "VariantParallel.hpp"
+#include <atomic>
+#include <cstddef>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace {
+    using Value = Variant<int, double, std::string>;
+
+    std::vector<Value> make_values(std::size_t size) {
+        std::vector<Value> values;
+        values.reserve(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            switch (i % 3) {
+            case 0:
+                values.emplace_back(static_cast<int>(i));
+                break;
+            case 1:
+                values.emplace_back(static_cast<double>(i));
+                break;
+            default:
+                values.emplace_back(std::string(i % 7, 'x'));
+                break;
+            }
+        }
+        return values;
+    }
+
+    long long weight(const Value& value) {
+        return value.visit([](const auto& alternative) -> long long {
+            if constexpr (std::is_same_v<std::remove_cvref_t<decltype(alternative)>, std::string>) {
+                return static_cast<long long>(alternative.size());
+            }
+            else {
+                return static_cast<long long>(alternative);
+            }
+        });
+    }
+}
+
+
+TEST(ParallelTest, VisitsEveryElementOnce) {
+    VariantThreadPool pool(4);
+    std::vector<Value> values = make_values(100000);
+
+    parallel_visit(pool, values, [](auto& alternative) {
+        if constexpr (std::is_same_v<std::remove_cvref_t<decltype(alternative)>, std::string>) {
+            alternative += "y";
+        }
+        else {
+            alternative += 1;
+        }
+    });
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        ASSERT_EQ(weight(values[i]), i % 3 == 2 ? static_cast<long long>(i % 7 + 1) : static_cast<long long>(i + 1));
+    }
+
+    std::atomic<std::size_t> strings{ 0 };
+    parallel_visit(std::as_const(values), [&strings](const auto& alternative) {
+        strings += std::is_same_v<std::remove_cvref_t<decltype(alternative)>, std::string>;
+    });
+    EXPECT_EQ(strings, values.size() / 3);
+}
+
+TEST(ParallelTest, TransformReduceMatchesSerial) {
+    const std::vector<Value> values = make_values(250000);
+    const long long expected = std::accumulate(values.begin(), values.end(), 7LL,
+        [](long long total, const Value& value) { return total + weight(value); });
+    auto transform = [](const auto& alternative) -> long long {
+        if constexpr (std::is_same_v<std::remove_cvref_t<decltype(alternative)>, std::string>) {
+            return static_cast<long long>(alternative.size());
+        }
+        else {
+            return static_cast<long long>(alternative);
+        }
+    };
+
+    for (std::size_t threads : { 1, 2, 3, 8 }) {
+        VariantThreadPool pool(threads);
+        EXPECT_EQ(parallel_transform_reduce(pool, values, 7LL, std::plus<>{}, transform), expected);
+    }
+    EXPECT_EQ(parallel_transform_reduce(values, 7LL, std::plus<>{}, transform), expected);
+    EXPECT_EQ(parallel_transform_reduce(std::vector<Value>{}, 7LL, std::plus<>{}, transform), 7);
+}
+
+TEST(ParallelTest, ReducesChunksInRangeOrder) {
+    VariantThreadPool pool(4);
+    std::vector<Value> values;
+    for (int i = 0; i < 20000; ++i) {
+        values.emplace_back(std::string(1, static_cast<char>('a' + i % 26)));
+    }
+    const std::string joined = parallel_transform_reduce(pool, values, std::string(), std::plus<>{},
+        [](const auto& alternative) {
+            if constexpr (std::is_same_v<std::remove_cvref_t<decltype(alternative)>, std::string>) {
+                return alternative;
+            }
+            else {
+                return std::string();
+            }
+        });
+    ASSERT_EQ(joined.size(), values.size());
+    for (std::size_t i = 0; i < joined.size(); ++i) {
+        ASSERT_EQ(joined[i], 'a' + i % 26);
+    }
+}
+
+TEST(ParallelTest, RethrowsFirstFailure) {
+    VariantThreadPool pool(4);
+    const std::vector<Value> values = make_values(100000);
+    EXPECT_THROW(parallel_visit(pool, values, [](const auto& alternative) {
+        if constexpr (std::is_same_v<std::remove_cvref_t<decltype(alternative)>, int>) {
+            if (alternative == 60000) {
+                throw std::runtime_error("visit failed");
+            }
+        }
+    }), std::runtime_error);
+
+    // The pool is usable after a failed job.
+    std::atomic<std::size_t> visited{ 0 };
+    parallel_visit(pool, values, [&visited](const auto&) { ++visited; });
+    EXPECT_EQ(visited, values.size());
+}
+
+TEST(ParallelTest, NestedCallsRunOnTheCallingThread) {
+    VariantThreadPool pool(4);
+    const std::vector<Value> outer = make_values(20000);
+    const std::vector<Value> inner = make_values(5000);
+    std::atomic<std::size_t> visited{ 0 };
+    parallel_visit(pool, outer, [&](const auto& alternative) {
+        if constexpr (std::is_same_v<std::remove_cvref_t<decltype(alternative)>, int>) {
+            if (alternative % 3000 == 0) {
+                parallel_visit(pool, inner, [&visited](const auto&) { ++visited; });
+            }
+        }
+    });
+    EXPECT_EQ(visited, 7 * inner.size());
+}
@@ -0,0 +1,137 @@
+#include "pch.h"
+#include "PointerVariant.hpp"
+#include "Variant.hpp"
+#include <cstdint>
+#include <type_traits>
+#include <variant>
+
+namespace {
+    struct Leaf;
+
+    // Names PointerVariant while Node and Leaf are still incomplete.
+    struct Node {
+        PointerVariant<Node*, Leaf*> left;
+        PointerVariant<Node*, Leaf*> right;
+    };
+
+    struct Leaf {
+        int value;
+    };
+
+    struct alignas(8) Ref {
+        std::int64_t target;
+    };
+
+    using Tree = PointerVariant<Node*, Leaf*, Ref*>;
+
+    template<template<typename...> class Link>
+    struct Branch {
+        Link<Branch*, Leaf*> next;
+    };
+}
+
+TEST(PointerVariantTest, IsASingleWord) {
+    static_assert(sizeof(Tree) == sizeof(std::uintptr_t));
+    static_assert(std::is_trivially_copyable_v<Tree>);
+    static_assert(Tree::alternatives_count == 3);
+}
+
+TEST(PointerVariantTest, NamesAClassTemplateBeingInstantiated) {
+    static_assert(sizeof(Branch<PointerVariant>) == sizeof(void*));
+    static_assert(sizeof(Branch<Variant>) >= sizeof(void*));
+}
+
+TEST(PointerVariantTest, DefaultHoldsNullFirstAlternative) {
+    Tree tree;
+    EXPECT_EQ(tree.index(), 0);
+    EXPECT_EQ(tree.get<Node*>(), nullptr);
+    EXPECT_FALSE(tree.valueless_by_exception());
+}
+
+TEST(PointerVariantTest, KeepsPointerAndIndex) {
+    Node node;
+    Leaf leaf{ 7 };
+    Ref ref{ 42 };
+
+    Tree tree(&leaf);
+    EXPECT_EQ(tree.index(), 1);
+    EXPECT_TRUE(tree.holds_alternative<Leaf*>());
+    EXPECT_EQ(tree.get<Leaf*>(), &leaf);
+    EXPECT_EQ(tree.get<1>()->value, 7);
+
+    tree = &ref;
+    EXPECT_EQ(tree.index(), 2);
+    EXPECT_EQ(tree.get<Ref*>()->target, 42);
+
+    EXPECT_EQ(tree.emplace<0>(&node), &node);
+    EXPECT_EQ(tree.get_if<Node*>(), &node);
+    EXPECT_EQ(tree.get_if<Leaf*>(), nullptr);
+
+    tree.emplace<Leaf*>(nullptr);
+    EXPECT_EQ(tree.index(), 1);
+    EXPECT_EQ(tree.get<Leaf*>(), nullptr);
+}
+
+TEST(PointerVariantTest, WrongAlternativeFailsLikeVariant) {
+    Leaf leaf{ 1 };
+    Tree tree(&leaf);
+    EXPECT_THROW(tree.get<Node*>(), std::bad_variant_access);
+    EXPECT_EQ((tree.get<Leaf*, VariantAccessPolicy::unchecked>()), &leaf);
+}
+
+TEST(PointerVariantTest, VisitsTheActivePointer) {
+    Leaf leaf{ 5 };
+    Node node{ &leaf, {} };
+
+    const auto count_leaves = [](auto&& self, PointerVariant<Node*, Leaf*> tree) -> int {
+        return tree.visit([&](auto pointer) -> int {
+            if (pointer == nullptr) {
+                return 0;
+            }
+            if constexpr (std::is_same_v<decltype(pointer), Leaf*>) {
+                return pointer->value;
+            }
+            else {
+                return self(self, pointer->left) + self(self, pointer->right);
+            }
+        });
+    };
+
+    PointerVariant<Node*, Leaf*> root(&node);
+    EXPECT_EQ(count_leaves(count_leaves, root), 5);
+}
+
+TEST(PointerVariantTest, FreeFunctionsMatchTheMembers) {
+    Leaf leaf{ 3 };
+    Tree tree(&leaf);
+    EXPECT_EQ(get<Leaf*>(tree), &leaf);
+    EXPECT_EQ(get<1>(tree), &leaf);
+    EXPECT_THROW(get<Node*>(tree), std::bad_variant_access);
+    EXPECT_EQ(get_if<Node*>(tree), nullptr);
+    EXPECT_EQ(get_if<1>(tree), &leaf);
+
+    const int value = visit([](auto pointer) -> int {
+        if constexpr (std::is_same_v<decltype(pointer), Leaf*>) {
+            return pointer->value;
+        }
+        else {
+            return 0;
+        }
+    }, tree);
+    EXPECT_EQ(value, 3);
+
+    // Overloads for Variant are visible too and do not interfere.
+    EXPECT_EQ(visit([](auto alternative) { return sizeof(alternative); }, Variant<char, int>(1)), sizeof(int));
+}
+
+TEST(PointerVariantTest, ComparesAndSwaps) {
+    Leaf first{ 1 };
+    Leaf second{ 2 };
+    Tree a(&first);
+    Tree b(&second);
+    EXPECT_NE(a, b);
+
+    a.swap(b);
+    EXPECT_EQ(a.get<Leaf*>(), &second);
+    EXPECT_EQ(b, Tree(&first));
+}
@@ -0,0 +1,116 @@
+#include "pch.h"
+#include "Variant.hpp"
+#include <memory>
+#include <new>
+#include <string>
+
+namespace {
+    struct Counted {
+        static inline int alive = 0;
+        static inline int moves = 0;
+
+        int value = 0;
+
+        Counted(int v) : value(v) { ++alive; }
+        Counted(Counted&& other) noexcept : value(other.value) { ++alive; ++moves; }
+        ~Counted() { --alive; }
+
+        static void reset() {
+            alive = 0;
+            moves = 0;
+        }
+    };
+
+    struct Relocatable {
+        int* resource;
+
+        explicit Relocatable(int v) : resource(new int(v)) {}
+        Relocatable(Relocatable&& other) noexcept : resource(other.resource) { other.resource = nullptr; }
+        ~Relocatable() { delete resource; }
+    };
+
+    template<typename Type>
+    struct Buffer {
+        alignas(Type) std::byte bytes[sizeof(Type) * 4];
+
+        Type* at(std::size_t i) { return reinterpret_cast<Type*>(bytes) + i; }
+    };
+}
+
+template<>
+struct meta_functions::is_trivially_relocatable<Relocatable> : std::true_type {};
+
+TEST(RelocationTest_trait, DetectsTriviallyRelocatableTypes) {
+    static_assert(meta_functions::is_trivially_relocatable_v<int>);
+    static_assert(meta_functions::is_trivially_relocatable_v<std::unique_ptr<int>>);
+    static_assert(meta_functions::is_trivially_relocatable_v<Relocatable>);
+    static_assert(!meta_functions::is_trivially_relocatable_v<Counted>);
+}
+
+TEST(RelocationTest_trait, VariantIsRelocatableWhenAllAlternativesAre) {
+    static_assert(meta_functions::is_trivially_relocatable_v<Variant<int, double>>);
+    static_assert(meta_functions::is_trivially_relocatable_v<Variant<int, std::unique_ptr<int>, Relocatable>>);
+    static_assert(!meta_functions::is_trivially_relocatable_v<Variant<int, Counted>>);
+}
+
+TEST(RelocationTest_relocate, MovesAndDestroysNonRelocatableType) {
+    Counted::reset();
+    Buffer<Counted> source;
+    Buffer<Counted> target;
+    std::construct_at(source.at(0), 7);
+
+    Counted* result = relocate(source.at(0), target.at(0));
+    EXPECT_EQ(result->value, 7);
+    EXPECT_EQ(Counted::moves, 1);
+    EXPECT_EQ(Counted::alive, 1);
+    std::destroy_at(result);
+}
+
+TEST(RelocationTest_relocate, RelocatesVariantWithUniquePtr) {
+    using V = Variant<int, std::unique_ptr<int>>;
+    Buffer<V> source;
+    Buffer<V> target;
+    std::construct_at(source.at(0), std::make_unique<int>(42));
+
+    V* result = relocate(source.at(0), target.at(0));
+    ASSERT_EQ(result->index(), 1);
+    EXPECT_EQ(*result->get<std::unique_ptr<int>>(), 42);
+    std::destroy_at(result);
+}
+
+TEST(RelocationTest_relocate_range, RelocatesEveryElement) {
+    using V = Variant<Relocatable, std::unique_ptr<int>>;
+    Buffer<V> source;
+    Buffer<V> target;
+    std::construct_at(source.at(0), Relocatable(1));
+    std::construct_at(source.at(1), std::make_unique<int>(2));
+    std::construct_at(source.at(2), Relocatable(3));
+
+    V* end = relocate_range(source.at(0), source.at(3), target.at(0));
+    EXPECT_EQ(end, target.at(3));
+    EXPECT_EQ(*target.at(0)->get<Relocatable>().resource, 1);
+    EXPECT_EQ(*target.at(1)->get<std::unique_ptr<int>>(), 2);
+    EXPECT_EQ(*target.at(2)->get<Relocatable>().resource, 3);
+    std::destroy(target.at(0), end);
+}
+
+TEST(RelocationTest_relocate_range, FallsBackToMoveAndDestroy) {
+    Counted::reset();
+    Buffer<Counted> source;
+    Buffer<Counted> target;
+    std::construct_at(source.at(0), 1);
+    std::construct_at(source.at(1), 2);
+
+    Counted* end = relocate_range(source.at(0), source.at(2), target.at(0));
+    EXPECT_EQ(Counted::moves, 2);
+    EXPECT_EQ(Counted::alive, 2);
+    EXPECT_EQ(target.at(1)->value, 2);
+    std::destroy(target.at(0), end);
+    EXPECT_EQ(Counted::alive, 0);
+}
+
+TEST(RelocationTest_relocate_range, AcceptsEmptyRange) {
+    Buffer<std::string> source;
+    Buffer<std::string> target;
+    EXPECT_EQ(relocate_range(source.at(0), source.at(0), target.at(0)), target.at(0));
+}
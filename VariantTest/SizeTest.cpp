@@ -0,0 +1,204 @@
+#include "pch.h"
+#include "Variant.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace {
+    struct ThrowingType {
+        ThrowingType() = default;
+        ThrowingType(int) {
+            throw std::runtime_error("construct fail");
+        }
+        ThrowingType(ThrowingType&&) {}
+    };
+
+    struct alignas(8) Aligned {
+        char data[12];
+    };
+
+    template<std::size_t I>
+    struct Alternative {
+        int value = static_cast<int>(I);
+    };
+
+    template<typename Sequence>
+    struct _Large_pack;
+
+    template<std::size_t... Is>
+    struct _Large_pack<std::index_sequence<Is...>> {
+        using variant = Variant<Alternative<Is>..., std::string>;
+    };
+
+    // More alternatives than variant_detail::_Flat_storage_threshold.
+    using LargeVariant = _Large_pack<std::make_index_sequence<32>>::variant;
+
+    struct Empty {};
+
+    struct Name {
+        char text[13];
+    };
+
+    enum class Kind : std::uint8_t { file, socket, pipe };
+
+    struct Handle {
+        std::uint32_t id;
+        Kind kind;
+    };
+}
+
+template<>
+struct meta_functions::niche_traits<Handle>
+    : meta_functions::value_niche_traits<Kind, Kind::pipe, offsetof(Handle, kind)> {};
+
+template<> struct meta_functions::enable_compact_layout<bool, Empty> : std::true_type {};
+template<> struct meta_functions::enable_compact_layout<int*, Empty> : std::true_type {};
+template<> struct meta_functions::enable_compact_layout<Handle, bool> : std::true_type {};
+template<> struct meta_functions::enable_compact_layout<Handle, bool, Kind, std::uint16_t> : std::true_type {};
+template<> struct meta_functions::enable_compact_layout<Handle, std::uint64_t> : std::true_type {};
+template<> struct meta_functions::enable_compact_layout<bool, Kind, int*> : std::true_type {};
+template<> struct meta_functions::enable_compact_layout<bool, ThrowingType> : std::true_type {};
+template<> struct meta_functions::enable_compact_layout<Variant<int, float>, int> : std::true_type {};
+template<> struct meta_functions::enable_compact_layout<Variant<bool, Empty>, Empty> : std::true_type {};
+template<> struct meta_functions::enable_compact_layout<Name, double> : std::true_type {};
+template<> struct meta_functions::enable_compact_layout<Name, std::uint16_t> : std::true_type {};
+template<> struct meta_functions::enable_compact_layout<Name, double, ThrowingType> : std::true_type {};
+template<> struct meta_functions::enable_compact_layout<Aligned, int> : std::true_type {};
+
+TEST(SizeTest, UsesSmallestIndexType) {
+    static_assert(sizeof(Variant<char>) == 2);
+    static_assert(sizeof(Variant<char, bool>) == 2);
+    static_assert(sizeof(Variant<short, char>) == 4);
+    static_assert(sizeof(Variant<int, float>) == 8);
+    static_assert(sizeof(Variant<int, double>) == 16);
+    static_assert(sizeof(Variant<Aligned, int>) == 24);
+}
+
+TEST(SizeTest, IndexDoesNotAffectAlignment) {
+    static_assert(alignof(Variant<char>) == 1);
+    static_assert(alignof(Variant<int, float>) == alignof(int));
+    static_assert(alignof(Variant<int, double>) == alignof(double));
+}
+
+TEST(SizeTest, IndexIsReportedAsSizeT) {
+    static_assert(std::is_same_v<decltype(std::declval<Variant<int>>().index()), std::size_t>);
+    Variant<int, float> v(1.0f);
+    EXPECT_EQ(v.index(), 1);
+}
+
+TEST(SizeTest, ValuelessIndexIsReportedAsNpos) {
+    static_assert(!Variant<int, ThrowingType>::never_valueless);
+    Variant<int, ThrowingType> v;
+    try { v.emplace<ThrowingType>(1); }
+    catch (...) {}
+    EXPECT_TRUE(v.valueless_by_exception());
+    EXPECT_EQ(v.index(), (Variant<int, ThrowingType>::npos));
+}
+
+TEST(SizeTest, FlatStorageKeepsUnionLayout) {
+    static_assert(sizeof(LargeVariant) == sizeof(Variant<int, std::string>));
+    static_assert(alignof(LargeVariant) == alignof(std::string));
+}
+
+TEST(SizeTest, FlatStorageHoldsEveryAlternative) {
+    LargeVariant v;
+    EXPECT_EQ(v.get<0>().value, 0);
+
+    v.emplace<31>();
+    EXPECT_EQ(v.get<Alternative<31>>().value, 31);
+
+    v = std::string("a string long enough to be allocated");
+    LargeVariant copy = v;
+    EXPECT_EQ(copy.index(), 32);
+    EXPECT_EQ(copy.get<std::string>(), "a string long enough to be allocated");
+
+    LargeVariant moved = std::move(copy);
+    EXPECT_EQ(moved.visit([](const auto& alternative) {
+        if constexpr (std::is_same_v<std::remove_cvref_t<decltype(alternative)>, std::string>) {
+            return alternative.size();
+        }
+        else {
+            return std::size_t(0);
+        }
+    }), std::string("a string long enough to be allocated").size());
+}
+
+TEST(SizeTest, NicheLayoutDropsTheIndex) {
+    static_assert(sizeof(Variant<bool, Empty>) == sizeof(bool));
+    static_assert(sizeof(Variant<int*, Empty>) == sizeof(int*));
+    static_assert(sizeof(Variant<Handle, bool, Kind, std::uint16_t>) == sizeof(Handle));
+    static_assert(alignof(Variant<Handle, bool, Kind, std::uint16_t>) == alignof(Handle));
+}
+
+TEST(SizeTest, NicheLayoutIsOptIn) {
+    static_assert(sizeof(Variant<Empty, bool>) == 2);
+    static_assert(variant_layout_v<Variant<Empty, bool>>.kind == VariantLayoutKind::tagged);
+}
+
+TEST(SizeTest, NicheLayoutNeedsRoomAroundTheNicheField) {
+    // A pointer's niches span all of its bytes, so nothing else fits beside it.
+    static_assert(sizeof(Variant<bool, Kind, int*>) == 2 * sizeof(int*));
+    static_assert(sizeof(Variant<Handle, std::uint64_t>) == 2 * sizeof(std::uint64_t));
+}
+
+TEST(SizeTest, NicheLayoutNeedsNeverValuelessAlternatives) {
+    static_assert(sizeof(Variant<bool, ThrowingType>) == 2);
+}
+
+TEST(SizeTest, NestedVariantLendsItsSpareIndexValues) {
+    static_assert(sizeof(Variant<Variant<int, float>, int>) == sizeof(Variant<int, float>));
+    static_assert(sizeof(Variant<Variant<bool, Empty>, Empty>) == sizeof(bool));
+    // Without the enclosing pack's opt-in the outer index keeps a member.
+    static_assert(sizeof(Variant<Variant<int, float>, float>) == sizeof(Variant<int, float>) + sizeof(float));
+}
+
+TEST(SizeTest, PackedLayoutUsesTailPadding) {
+    using Tail = Variant<Name, double>;
+    static_assert(sizeof(Tail) == 16);
+    static_assert(variant_layout_v<Tail>.kind == VariantLayoutKind::packed);
+    static_assert(variant_layout_v<Tail>.index_offset == 13);
+
+    static_assert(sizeof(Variant<Name, std::uint16_t>) == 14);
+    // Padding inside an alternative is part of it: copies may overwrite it.
+    static_assert(variant_layout_v<Variant<Aligned, int>>.kind == VariantLayoutKind::tagged);
+}
+
+TEST(SizeTest, PackedLayoutIsOptIn) {
+    static_assert(sizeof(Variant<Name, float>) == 20);
+    static_assert(variant_layout_v<Variant<Name, float>>.kind == VariantLayoutKind::tagged);
+}
+
+TEST(SizeTest, PackedLayoutHoldsEveryAlternative) {
+    Variant<Name, double, ThrowingType> v(2.5);
+    EXPECT_EQ(v.index(), 1);
+    EXPECT_DOUBLE_EQ(v.get<double>(), 2.5);
+
+    v.emplace<Name>(Name{ "twelve chars" });
+    EXPECT_STREQ(v.get<Name>().text, "twelve chars");
+
+    auto moved = std::move(v);
+    EXPECT_EQ(moved.index(), 0);
+    EXPECT_STREQ(moved.get<Name>().text, "twelve chars");
+    EXPECT_TRUE(v.valueless_by_exception());
+
+    try { moved.emplace<ThrowingType>(1); }
+    catch (...) {}
+    EXPECT_TRUE(moved.valueless_by_exception());
+    EXPECT_EQ(moved.index(), (Variant<Name, double, ThrowingType>::npos));
+}
+
+TEST(SizeTest, LayoutReportDescribesTheIndex) {
+    constexpr VariantLayout tagged = variant_layout_v<Variant<int, double>>;
+    static_assert(tagged.kind == VariantLayoutKind::tagged);
+    static_assert(tagged.size == 16 && tagged.alignment == 8);
+    static_assert(tagged.index_offset == 8 && tagged.index_size == 1);
+
+    constexpr VariantLayout niche = variant_layout_v<Variant<Handle, bool>>;
+    static_assert(niche.kind == VariantLayoutKind::niche);
+    static_assert(niche.size == sizeof(Handle));
+    static_assert(niche.index_offset == offsetof(Handle, kind) && niche.index_size == 1);
+
+    static_assert(variant_layout_v<const LargeVariant&>.size == sizeof(LargeVariant));
+}
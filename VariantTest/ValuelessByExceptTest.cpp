@@ -1,4 +1,153 @@
 #include "pch.h"
 #include "Variant.hpp"
+#include <stdexcept>
+#include <string>
+#include <vector>
 
+namespace {
+    // Throws on demand when constructed from an int; its move constructor is
+    // noexcept, so a Variant of it and std::string is never valueless.
+    struct NothrowMovable {
+        static inline bool fail = false;
 
+        int value = 0;
+
+        NothrowMovable() = default;
+        NothrowMovable(int v) : value(v) {
+            if (fail) throw std::runtime_error("construct fail");
+        }
+        NothrowMovable(const NothrowMovable& other) : value(other.value) {
+            if (fail) throw std::runtime_error("copy fail");
+        }
+        NothrowMovable(NothrowMovable&&) noexcept = default;
+        NothrowMovable& operator=(const NothrowMovable&) = default;
+        NothrowMovable& operator=(NothrowMovable&&) noexcept = default;
+
+        bool operator==(const NothrowMovable&) const = default;
+    };
+
+    // Same, but its move constructor may throw, so the Variant can become
+    // valueless.
+    struct ThrowingMovable {
+        static inline bool fail = false;
+
+        int value = 0;
+
+        ThrowingMovable() = default;
+        ThrowingMovable(int v) : value(v) {
+            if (fail) throw std::runtime_error("construct fail");
+        }
+        ThrowingMovable(const ThrowingMovable&) = default;
+        ThrowingMovable(ThrowingMovable&& other) noexcept(false) : value(other.value) {}
+        ThrowingMovable& operator=(const ThrowingMovable&) = default;
+        ThrowingMovable& operator=(ThrowingMovable&&) = default;
+
+        bool operator==(const ThrowingMovable&) const = default;
+    };
+
+    using NeverValueless = Variant<std::string, NothrowMovable>;
+    using MaybeValueless = Variant<std::string, ThrowingMovable>;
+
+    struct FailScope {
+        FailScope() { NothrowMovable::fail = ThrowingMovable::fail = true; }
+        ~FailScope() { NothrowMovable::fail = ThrowingMovable::fail = false; }
+    };
+}
+
+TEST(ValuelessByExceptTest_Trait, IsNeverValuelessIf_AllTypesAreNothrowMovable) {
+    static_assert(NeverValueless::never_valueless);
+    static_assert(Variant<int, double, std::vector<int>>::never_valueless);
+    static_assert(!MaybeValueless::never_valueless);
+}
+
+TEST(ValuelessByExceptTest_NeverValueless, EmplaceKeepsOldValueIf_ConstructionThrows) {
+    NeverValueless v(std::string("keep"));
+    {
+        FailScope fail;
+        EXPECT_THROW(v.emplace<NothrowMovable>(1), std::runtime_error);
+    }
+    EXPECT_FALSE(v.valueless_by_exception());
+    EXPECT_EQ(v.index(), 0);
+    EXPECT_EQ(v.get<std::string>(), "keep");
+}
+
+TEST(ValuelessByExceptTest_NeverValueless, EmplaceKeepsSameAlternativeIf_ConstructionThrows) {
+    NeverValueless v(std::in_place_type<NothrowMovable>, 5);
+    {
+        FailScope fail;
+        EXPECT_THROW(v.emplace<1>(6), std::runtime_error);
+    }
+    EXPECT_EQ(v.get<NothrowMovable>().value, 5);
+}
+
+TEST(ValuelessByExceptTest_NeverValueless, CopyAssignmentKeepsOldValueIf_CopyThrows) {
+    NeverValueless source(std::in_place_type<NothrowMovable>, 3);
+    NeverValueless v(std::string("keep"));
+    {
+        FailScope fail;
+        EXPECT_THROW(v = source, std::runtime_error);
+    }
+    EXPECT_EQ(v.get<std::string>(), "keep");
+}
+
+TEST(ValuelessByExceptTest_NeverValueless, ValueAssignmentKeepsOldValueIf_CopyThrows) {
+    const NothrowMovable value;
+    NeverValueless v(std::string("keep"));
+    {
+        FailScope fail;
+        EXPECT_THROW(v = value, std::runtime_error);
+    }
+    EXPECT_EQ(v.get<std::string>(), "keep");
+}
+
+TEST(ValuelessByExceptTest_NeverValueless, MovedFromVariantKeepsItsAlternative) {
+    NeverValueless source(std::string("moved"));
+    NeverValueless constructed = std::move(source);
+    EXPECT_EQ(source.index(), 0);
+
+    NeverValueless assigned(std::in_place_type<NothrowMovable>, 1);
+    assigned = std::move(constructed);
+    EXPECT_EQ(constructed.index(), 0);
+    EXPECT_EQ(assigned.get<std::string>(), "moved");
+}
+
+TEST(ValuelessByExceptTest_MaybeValueless, EmplaceBecomesValuelessIf_ConstructionThrows) {
+    MaybeValueless v(std::string("lost"));
+    {
+        FailScope fail;
+        EXPECT_THROW(v.emplace<ThrowingMovable>(1), std::runtime_error);
+    }
+    EXPECT_TRUE(v.valueless_by_exception());
+    EXPECT_EQ(v.index(), MaybeValueless::npos);
+    EXPECT_THROW(v.get<std::string>(), std::bad_variant_access);
+    EXPECT_EQ(v.get_if<0>(), nullptr);
+}
+
+TEST(ValuelessByExceptTest_MaybeValueless, RecoversAfterEmplace) {
+    MaybeValueless v;
+    {
+        FailScope fail;
+        EXPECT_THROW(v.emplace<ThrowingMovable>(1), std::runtime_error);
+    }
+    v.emplace<ThrowingMovable>(2);
+    EXPECT_FALSE(v.valueless_by_exception());
+    EXPECT_EQ(v.get<ThrowingMovable>().value, 2);
+}
+
+TEST(ValuelessByExceptTest_MaybeValueless, MovedFromVariantBecomesValueless) {
+    MaybeValueless source(std::string("moved"));
+    MaybeValueless target = std::move(source);
+    EXPECT_TRUE(source.valueless_by_exception());
+    EXPECT_EQ(target.get<std::string>(), "moved");
+}
+
+TEST(ValuelessByExceptTest_MaybeValueless, ValuelessVariantsCompareEqual) {
+    MaybeValueless v1, v2;
+    {
+        FailScope fail;
+        EXPECT_THROW(v1.emplace<ThrowingMovable>(1), std::runtime_error);
+        EXPECT_THROW(v2.emplace<ThrowingMovable>(1), std::runtime_error);
+    }
+    EXPECT_TRUE(v1 == v2);
+    EXPECT_FALSE(v1 == MaybeValueless());
+}
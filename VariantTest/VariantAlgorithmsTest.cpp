@@ -0,0 +1,190 @@
+#include "pch.h"
+#include "VariantAlgorithms.hpp"
+#include <array>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace {
+    using Value = Variant<int, std::string, double>;
+    using Array = VariantArray<int, std::string, double>;
+
+    std::vector<std::uint8_t> random_tags(std::size_t size, std::uint8_t alternatives) {
+        std::mt19937 engine(static_cast<unsigned>(size));
+        std::vector<std::uint8_t> tags(size);
+        for (auto& tag : tags) {
+            tag = static_cast<std::uint8_t>(engine() % alternatives);
+        }
+        return tags;
+    }
+
+    Array make_array(std::size_t size) {
+        Array array;
+        for (std::size_t i = 0; i < size; ++i) {
+            switch (i % 7 % 3) {
+            case 0:
+                array.push_back(static_cast<int>(i));
+                break;
+            case 1:
+                array.push_back(std::to_string(i));
+                break;
+            default:
+                array.push_back(static_cast<double>(i));
+                break;
+            }
+        }
+        return array;
+    }
+}
+
+TEST(VariantAlgorithmsTest, KernelsAgreeWithTheScalarScan) {
+    namespace detail = variant_detail;
+    for (std::size_t size : { 0, 1, 15, 16, 17, 31, 32, 33, 100, 255 * 32 + 7, 20000 }) {
+        const std::vector<std::uint8_t> tags = random_tags(size, 5);
+        for (std::uint8_t tag = 0; tag < 6; ++tag) {
+            const std::size_t expected = detail::_Count_tag_scalar(tags.data(), size, tag);
+            EXPECT_EQ(detail::_Count_tag(tags.data(), size, tag), expected);
+            for (std::size_t from : { std::size_t(0), size / 3, size }) {
+                EXPECT_EQ(detail::_Find_tag(tags.data(), size, from, tag),
+                    detail::_Find_tag_scalar(tags.data(), size, from, tag));
+            }
+#ifdef VARIANT_X86_SIMD
+            if (detail::_Supported_simd_level() >= detail::_Simd_level::sse2) {
+                EXPECT_EQ(detail::_Count_tag_sse2(tags.data(), size, tag), expected);
+                EXPECT_EQ(detail::_Find_tag_sse2(tags.data(), size, 0, tag),
+                    detail::_Find_tag_scalar(tags.data(), size, 0, tag));
+            }
+            if (detail::_Supported_simd_level() >= detail::_Simd_level::avx2) {
+                EXPECT_EQ(detail::_Count_tag_avx2(tags.data(), size, tag), expected);
+                EXPECT_EQ(detail::_Find_tag_avx2(tags.data(), size, 0, tag),
+                    detail::_Find_tag_scalar(tags.data(), size, 0, tag));
+            }
+#endif
+        }
+
+        std::array<std::size_t, 5> expected_counts{};
+        detail::_Tag_histogram_scalar(tags.data(), size, expected_counts.data());
+        std::array<std::size_t, 5> counts{};
+        detail::_Tag_histogram<5>(tags.data(), size, counts.data());
+        EXPECT_EQ(counts, expected_counts);
+#ifdef VARIANT_X86_SIMD
+        if (detail::_Supported_simd_level() >= detail::_Simd_level::sse2) {
+            std::array<std::size_t, 5> sse2_counts{};
+            detail::_Tag_histogram_sse2<5>(tags.data(), size, sse2_counts.data());
+            EXPECT_EQ(sse2_counts, expected_counts);
+        }
+        if (detail::_Supported_simd_level() >= detail::_Simd_level::avx2) {
+            std::array<std::size_t, 5> avx2_counts{};
+            detail::_Tag_histogram_avx2<5>(tags.data(), size, avx2_counts.data());
+            EXPECT_EQ(avx2_counts, expected_counts);
+        }
+#endif
+    }
+}
+
+TEST(VariantAlgorithmsTest, ViewsSelectOneAlternative) {
+    const std::vector<Value> values{ 1, std::string("a"), 2.0, 3, std::string("b") };
+    std::vector<int> ints;
+    for (const int& value : values | variant_views::alternative<int>) {
+        ints.push_back(value);
+    }
+    EXPECT_EQ(ints, (std::vector<int>{ 1, 3 }));
+
+    Array array = make_array(100);
+    std::size_t strings = 0;
+    for (std::string& text : array | variant_views::alternative<std::string>) {
+        text += "!";
+        ++strings;
+    }
+    EXPECT_EQ(strings, array.count<std::string>());
+    EXPECT_EQ(array[1].get<std::string>(), "1!");
+
+    const Array& view = array;
+    auto doubles = variant_views::alternative<double>(view);
+    static_assert(std::ranges::forward_range<decltype(doubles)>);
+    static_assert(std::is_same_v<decltype(*doubles.begin()), const double&>);
+    EXPECT_EQ(*doubles.begin(), 2.0);
+    EXPECT_EQ(doubles.begin().position(), 2);
+}
+
+TEST(VariantAlgorithmsTest, CountsAndHistograms) {
+    const Array array = make_array(1000);
+    const std::vector<Value> values(1000, Value(std::string("x")));
+
+    EXPECT_EQ(count_alternative<int>(array), array.count<int>());
+    EXPECT_EQ(count_alternative<std::string>(values), 1000);
+    EXPECT_EQ(count_alternative<int>(values), 0);
+
+    const auto histogram = index_histogram(array);
+    EXPECT_EQ(histogram[0] + histogram[1] + histogram[2], 1000);
+    EXPECT_EQ(histogram[1], array.count<std::string>());
+    EXPECT_EQ(index_histogram(values), (std::array<std::size_t, 3>{ 0, 1000, 0 }));
+}
+
+TEST(VariantAlgorithmsTest, PartitionsPositionsByIndex) {
+    const Array array = make_array(200);
+    const auto positions = partition_by_index(array);
+    for (std::size_t index = 0; index < 3; ++index) {
+        EXPECT_EQ(positions[index].size(), array.count(index));
+        for (std::size_t position : positions[index]) {
+            EXPECT_EQ(array.index(position), index);
+        }
+    }
+
+    const std::vector<Value> values{ 1.0, 2, 3.0 };
+    const auto value_positions = partition_by_index(values);
+    EXPECT_EQ(value_positions[0], (std::vector<std::size_t>{ 1 }));
+    EXPECT_EQ(value_positions[2], (std::vector<std::size_t>{ 0, 2 }));
+}
+
+TEST(VariantAlgorithmsTest, VisitsBatchesInIndexOrder) {
+    std::vector<Value> values{ 1.5, 1, std::string("a"), 2, 2.5, std::string("b") };
+    std::string trace;
+    visit_batch(values, [&trace](auto& alternative) {
+        using Type = std::remove_cvref_t<decltype(alternative)>;
+        if constexpr (std::is_same_v<Type, std::string>) {
+            trace += alternative;
+            alternative += "!";
+        }
+        else {
+            trace += std::to_string(static_cast<int>(alternative * 2));
+        }
+        trace += ' ';
+    });
+    EXPECT_EQ(trace, "2 4 a b 3 5 ");
+    EXPECT_EQ(values[5].get<std::string>(), "b!");
+
+    Array array = make_array(300);
+    std::size_t ints = 0, doubles = 0;
+    std::size_t last_index = 0;
+    visit_batch(array, [&](const auto& alternative) {
+        using Type = std::remove_cvref_t<decltype(alternative)>;
+        const std::size_t index = meta_functions::_Get_index_v<Type, int, std::string, double>;
+        EXPECT_GE(index, last_index);
+        last_index = index;
+        ints += std::is_same_v<Type, int>;
+        doubles += std::is_same_v<Type, double>;
+    });
+    EXPECT_EQ(ints, array.count<int>());
+    EXPECT_EQ(doubles, array.count<double>());
+}
+
+TEST(VariantAlgorithmsTest, VisitsCollectionSegmentsAsSpans) {
+    VariantCollection<int, std::string> collection;
+    collection.insert(1);
+    collection.insert(std::string("a"));
+    collection.insert(2);
+
+    std::vector<std::size_t> sizes;
+    visit_batch<VariantBatchMode::spans>(collection, [&sizes](auto segment) {
+        sizes.push_back(segment.size());
+    });
+    EXPECT_EQ(sizes, (std::vector<std::size_t>{ 2, 1 }));
+
+    std::size_t elements = 0;
+    visit_batch(std::as_const(collection), [&elements](const auto&) { ++elements; });
+    EXPECT_EQ(elements, 3);
+}
@@ -0,0 +1,156 @@
+#include "pch.h"
+#include "VariantArray.hpp"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+namespace {
+    using Array = VariantArray<int, std::string, double>;
+
+    struct Counted {
+        static inline int alive = 0;
+
+        int value;
+
+        Counted(int value) : value(value) {
+            ++alive;
+        }
+
+        Counted(const Counted& other) : value(other.value) {
+            ++alive;
+        }
+
+        Counted(Counted&& other) noexcept : value(other.value) {
+            ++alive;
+        }
+
+        ~Counted() {
+            --alive;
+        }
+    };
+}
+
+TEST(VariantArrayTest, KeepsTagsAndPayloadsInSeparateColumns) {
+    static_assert(std::is_same_v<Array::tag_type, std::uint8_t>);
+
+    Array array;
+    EXPECT_TRUE(array.empty());
+
+    array.push_back(1);
+    array.push_back(std::string("two"));
+    array.emplace_back<double>(3.0);
+    array.emplace_back<0>(4);
+
+    ASSERT_EQ(array.size(), 4);
+    EXPECT_EQ(std::vector<std::uint8_t>(array.tags().begin(), array.tags().end()),
+        (std::vector<std::uint8_t>{ 0, 1, 2, 0 }));
+    EXPECT_EQ(array.index(1), 1);
+    EXPECT_EQ(array.count<int>(), 2);
+    EXPECT_EQ(array.count(2), 1);
+    EXPECT_EQ(array.histogram(), (std::array<std::size_t, 3>{ 2, 1, 1 }));
+}
+
+TEST(VariantArrayTest, ElementsBehaveLikeVariants) {
+    Array array;
+    array.push_back(Variant<int, std::string, double>(std::string("text")));
+    array.push_back(7);
+
+    EXPECT_TRUE(array[0].holds_alternative<std::string>());
+    EXPECT_EQ(array[0].get<std::string>(), "text");
+    EXPECT_EQ(array[1].get<0>(), 7);
+    EXPECT_EQ(array[1].get_if<double>(), nullptr);
+    EXPECT_THROW(array[1].get<std::string>(), std::bad_variant_access);
+    EXPECT_EQ(array[0].visit([](const auto& value) { return sizeof(value); }), sizeof(std::string));
+
+    array[1] = 8;
+    EXPECT_EQ(array[1].get<int>(), 8);
+    array[1] = std::string("replaced");
+    EXPECT_EQ(array[1].get<std::string>(), "replaced");
+    array[0].emplace<double>(1.5);
+    EXPECT_EQ(array.histogram(), (std::array<std::size_t, 3>{ 0, 1, 1 }));
+
+    const Variant<int, std::string, double> copy = array[1];
+    EXPECT_EQ(copy.get<std::string>(), "replaced");
+
+    const Array& view = array;
+    static_assert(std::is_same_v<decltype(view[0].get<double>()), const double&>);
+    EXPECT_EQ(view[0].get<double>(), 1.5);
+}
+
+TEST(VariantArrayTest, IteratesAllElementsOrOneAlternative) {
+    Array array;
+    for (int i = 0; i < 10; ++i) {
+        if (i % 3 == 0) {
+            array.push_back(std::to_string(i));
+        }
+        else {
+            array.push_back(i);
+        }
+    }
+
+    int sum = 0;
+    array.for_each_of<int>([&sum](int value) { sum += value; });
+    EXPECT_EQ(sum, 1 + 2 + 4 + 5 + 7 + 8);
+
+    std::string joined;
+    array.for_each([&joined](const auto& value) {
+        if constexpr (std::is_same_v<std::remove_cvref_t<decltype(value)>, std::string>) {
+            joined += value;
+        }
+    });
+    EXPECT_EQ(joined, "0369");
+
+    array.for_each_of<std::string>([](std::string& value) { value += "!"; });
+    EXPECT_EQ(array[9].get<std::string>(), "9!");
+}
+
+TEST(VariantArrayTest, AppendsInBatches) {
+    Array array(3, 2.5);
+    array.append(1000, 1);
+    array.append(2, std::string("s"));
+
+    EXPECT_EQ(array.size(), 1005);
+    EXPECT_EQ(array.histogram(), (std::array<std::size_t, 3>{ 1000, 2, 3 }));
+    EXPECT_EQ(array[1004].get<std::string>(), "s");
+    EXPECT_EQ(array[500].get<int>(), 1);
+}
+
+TEST(VariantArrayTest, ManagesLifetimes) {
+    {
+        VariantArray<int, Counted> array;
+        for (int i = 0; i < 100; ++i) {
+            array.emplace_back<Counted>(i);
+            array.push_back(i);
+        }
+        EXPECT_EQ(Counted::alive, 100);
+
+        VariantArray<int, Counted> copy = array;
+        EXPECT_EQ(Counted::alive, 200);
+        EXPECT_EQ(copy[198].get<Counted>().value, 99);
+
+        VariantArray<int, Counted> moved = std::move(copy);
+        EXPECT_EQ(Counted::alive, 200);
+
+        moved[0] = 5;
+        array.pop_back();
+        array.pop_back();
+        EXPECT_EQ(Counted::alive, 198);
+
+        array.clear();
+        EXPECT_EQ(Counted::alive, 99);
+    }
+    EXPECT_EQ(Counted::alive, 0);
+}
+
+TEST(VariantArrayTest, PushesBackAnElementOfItself) {
+    Array array;
+    array.push_back(std::string("a long string that does not fit in place"));
+    while (array.size() < array.capacity()) {
+        array.push_back(0);
+    }
+    array.push_back(array[0].get<std::string>());
+    EXPECT_EQ(array[array.size() - 1].get<std::string>(), "a long string that does not fit in place");
+}
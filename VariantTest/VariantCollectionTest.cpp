@@ -0,0 +1,154 @@
+#include "pch.h"
+#include "VariantCollection.hpp"
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace {
+    using Collection = VariantCollection<int, std::string, double>;
+
+    struct Recorder {
+        std::vector<std::string> seen;
+
+        void operator()(int value) {
+            seen.push_back("int " + std::to_string(value));
+        }
+
+        void operator()(const std::string& value) {
+            seen.push_back("string " + value);
+        }
+
+        void operator()(double value) {
+            seen.push_back("double " + std::to_string(static_cast<int>(value)));
+        }
+    };
+
+    constexpr std::size_t count_kept_flags() {
+        VariantCollection<bool> flags;
+        for (int i = 0; i < 10; ++i) {
+            flags.insert(i % 2 == 0);
+        }
+        VariantCollection<bool> copy = flags;
+        copy.erase<bool>(0);
+        return copy.erase_if([](bool flag) { return !flag; }) + copy.size();
+    }
+}
+
+TEST(VariantCollectionTest, GroupsElementsBySegment) {
+    Collection collection;
+    EXPECT_TRUE(collection.empty());
+
+    collection.insert(1);
+    collection.insert(std::string("a"));
+    collection.emplace<double>(2.0);
+    collection.insert(3);
+    collection.emplace<std::string>(2, 'b');
+
+    EXPECT_EQ(collection.size(), 5);
+    EXPECT_EQ(collection.size<int>(), 2);
+    EXPECT_EQ(collection.size<std::string>(), 2);
+    EXPECT_EQ(collection.size<double>(), 1);
+
+    Recorder recorder;
+    collection.for_each(recorder);
+    EXPECT_EQ(recorder.seen, (std::vector<std::string>{
+        "int 1", "int 3", "string a", "string bb", "double 2" }));
+}
+
+TEST(VariantCollectionTest, InsertsTheActiveAlternativeOfAVariant) {
+    Collection collection;
+    const Collection::variant_type text(std::string("text"));
+    Collection::variant_type number(7);
+
+    collection.insert(text);
+    collection.insert(std::move(number));
+
+    ASSERT_EQ(collection.size(), 2);
+    EXPECT_EQ(collection.segment<std::string>()[0], "text");
+    EXPECT_EQ(collection.segment<int>()[0], 7);
+    EXPECT_EQ(text.get<std::string>(), "text");
+}
+
+TEST(VariantCollectionTest, ForEachCanModifyElements) {
+    Collection collection;
+    collection.insert(1);
+    collection.insert(2.5);
+    collection.insert(std::string("x"));
+
+    collection.for_each([](auto& element) { element += element; });
+
+    EXPECT_EQ(collection.segment<int>()[0], 2);
+    EXPECT_EQ(collection.segment<double>()[0], 5.0);
+    EXPECT_EQ(collection.segment<std::string>()[0], "xx");
+
+    int calls = 0;
+    const Collection& view = collection;
+    view.for_each([&calls](const auto&) { ++calls; });
+    EXPECT_EQ(calls, 3);
+}
+
+TEST(VariantCollectionTest, Erases) {
+    Collection collection;
+    for (int i = 0; i < 6; ++i) {
+        collection.insert(i);
+        collection.insert(static_cast<double>(i));
+    }
+    collection.insert(std::string("keep"));
+
+    collection.erase<int>(0);
+    EXPECT_EQ(collection.size<int>(), 5);
+    EXPECT_EQ(collection.segment<int>()[0], 1);
+
+    const std::size_t removed = collection.erase_if([](const auto& element) {
+        if constexpr (std::is_same_v<std::remove_cvref_t<decltype(element)>, std::string>) {
+            return element.empty();
+        }
+        else {
+            return element >= 3;
+        }
+    });
+    EXPECT_EQ(removed, 6);
+    EXPECT_EQ(collection.size<int>(), 2);
+    EXPECT_EQ(collection.size<double>(), 3);
+    EXPECT_EQ(collection.size<std::string>(), 1);
+
+    collection.clear();
+    EXPECT_TRUE(collection.empty());
+}
+
+TEST(VariantCollectionTest, KeepsBoolsContiguous) {
+    VariantCollection<int, bool> collection;
+    for (int i = 0; i < 20; ++i) {
+        collection.insert(i % 3 == 0);
+    }
+    collection.insert(7);
+
+    static_assert(std::is_same_v<decltype(collection.segment<bool>()), std::span<bool>>);
+    const std::span<bool> flags = collection.segment<bool>();
+    ASSERT_EQ(flags.size(), 20);
+    EXPECT_TRUE(flags[0]);
+    EXPECT_FALSE(flags[1]);
+    EXPECT_EQ(&flags[1], &flags[0] + 1);
+
+    collection.for_each([](auto& element) {
+        if constexpr (std::is_same_v<std::remove_cvref_t<decltype(element)>, bool>) {
+            element = !element;
+        }
+    });
+    EXPECT_FALSE(flags[0]);
+    EXPECT_TRUE(flags[1]);
+
+    const VariantCollection<int, bool> copy = collection;
+    collection.erase<bool>(0);
+    EXPECT_EQ(collection.size<bool>(), 19);
+    EXPECT_TRUE(collection.segment<bool>()[0]);
+    EXPECT_EQ(copy.size<bool>(), 20);
+    EXPECT_FALSE(copy.segment<bool>()[0]);
+
+    EXPECT_EQ(collection.erase_if([](auto element) { return element == true; }), 13);
+    EXPECT_EQ(collection.size<bool>(), 6);
+    EXPECT_EQ(collection.size<int>(), 1);
+
+    static_assert(count_kept_flags() == 5 + 4);
+}
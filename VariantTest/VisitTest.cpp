@@ -0,0 +1,176 @@
+#include "pch.h"
+#include "Variant.hpp"
+#include <string>
+
+namespace {
+    struct ThrowingType {
+        ThrowingType() = default;
+        ThrowingType(int) {
+            throw std::runtime_error("construct fail");
+        }
+        ThrowingType(ThrowingType&&) {}
+    };
+
+    struct Overloaded {
+        int operator()(int) const { return 0; }
+        int operator()(double) const { return 1; }
+        int operator()(const std::string&) const { return 2; }
+    };
+
+    struct CategoryVisitor {
+        int operator()(std::string&) const { return 0; }
+        int operator()(const std::string&) const { return 1; }
+        int operator()(std::string&&) const { return 2; }
+        int operator()(const std::string&&) const { return 3; }
+    };
+
+    template<std::size_t I>
+    struct Tag {
+        std::size_t value = I;
+    };
+
+    using Tags16 = Variant<Tag<0>, Tag<1>, Tag<2>, Tag<3>, Tag<4>, Tag<5>, Tag<6>, Tag<7>,
+        Tag<8>, Tag<9>, Tag<10>, Tag<11>, Tag<12>, Tag<13>, Tag<14>, Tag<15>>;
+}
+
+TEST(VisitTest, CallsVisitorWithActiveAlternative) {
+    Variant<int, double, std::string> v(std::in_place_type<std::string>, "abc");
+    EXPECT_EQ(v.visit(Overloaded{}), 2);
+    v = 3.14;
+    EXPECT_EQ(v.visit(Overloaded{}), 1);
+    v = 42;
+    EXPECT_EQ(v.visit(Overloaded{}), 0);
+}
+
+TEST(VisitTest, FreeFunctionMatchesMember) {
+    Variant<int, double, std::string> v(2.5);
+    EXPECT_EQ(visit(Overloaded{}, v), v.visit(Overloaded{}));
+}
+
+TEST(VisitTest, PreservesValueCategory) {
+    Variant<int, std::string> v(std::in_place_type<std::string>, "abc");
+    const Variant<int, std::string>& cref = v;
+    auto visitor = [](auto&& value) -> int {
+        if constexpr (std::is_same_v<std::remove_cvref_t<decltype(value)>, std::string>) {
+            return CategoryVisitor{}(std::forward<decltype(value)>(value));
+        }
+        else {
+            return -1;
+        }
+    };
+    EXPECT_EQ(v.visit(visitor), 0);
+    EXPECT_EQ(cref.visit(visitor), 1);
+    EXPECT_EQ(std::move(v).visit(visitor), 2);
+    EXPECT_EQ(std::move(cref).visit(visitor), 3);
+}
+
+TEST(VisitTest, ReturnsReferenceToAlternative) {
+    Variant<int, double> v(1.5);
+    double& ref = v.visit([](auto& value) -> double& {
+        static double fallback = 0.0;
+        if constexpr (std::is_same_v<std::remove_cvref_t<decltype(value)>, double>) {
+            return value;
+        }
+        else {
+            return fallback;
+        }
+    });
+    ref = 2.5;
+    EXPECT_EQ(v.get<double>(), 2.5);
+}
+
+TEST(VisitTest, VisitorCanModifyAlternative) {
+    Variant<int, std::string> v(std::in_place_type<std::string>, "abc");
+    visit([](auto& value) { value += value; }, v);
+    EXPECT_EQ(v.get<std::string>(), "abcabc");
+}
+
+TEST(VisitTest, ThrowsIf_Valueless) {
+    static_assert(!Variant<ThrowingType>::never_valueless);
+    Variant<ThrowingType> v;
+    try { v.emplace<ThrowingType>(1); }
+    catch (...) {}
+    EXPECT_THROW(v.visit([](auto&) {}), std::bad_variant_access);
+}
+
+TEST(VisitTest, DispatchesLargePacks) {
+    Tags16 v;
+    EXPECT_EQ(v.visit([](const auto& tag) { return tag.value; }), 0);
+    v.emplace<11>();
+    EXPECT_EQ(v.visit([](const auto& tag) { return tag.value; }), 11);
+    v.emplace<Tag<15>>();
+    EXPECT_EQ(visit([](const auto& tag) { return tag.value; }, v), 15);
+}
+
+TEST(VisitTest, IsConstexpr) {
+    constexpr Variant<int, double> v(2.0);
+    static_assert(v.visit([](auto value) { return static_cast<int>(value) * 2; }) == 4);
+    static_assert(visit([](auto value) { return static_cast<int>(value); }, v) == 2);
+}
+
+TEST(MultiVisitTest, CallsVisitorWithAllActiveAlternatives) {
+    Variant<int, double, std::string> v1(2.5);
+    Variant<int, std::string> v2(std::in_place_type<std::string>, "abc");
+    auto visitor = [](const auto& lhs, const auto& rhs) {
+        return Overloaded{}(lhs) * 10 + Overloaded{}(rhs);
+    };
+    EXPECT_EQ(visit(visitor, v1, v2), 12);
+    v1 = 7;
+    v2 = 3;
+    EXPECT_EQ(visit(visitor, v1, v2), 0);
+}
+
+TEST(MultiVisitTest, VisitsThreeVariants) {
+    Variant<Tag<0>, Tag<1>, Tag<2>, Tag<3>> v1(std::in_place_index<3>);
+    Variant<Tag<0>, Tag<1>> v2(std::in_place_index<1>);
+    Variant<Tag<0>, Tag<1>, Tag<2>> v3(std::in_place_index<2>);
+    auto visitor = [](const auto& a, const auto& b, const auto& c) {
+        return a.value * 100 + b.value * 10 + c.value;
+    };
+    EXPECT_EQ(visit(visitor, v1, v2, v3), 312);
+    v1.emplace<0>();
+    v3.emplace<1>();
+    EXPECT_EQ(visit(visitor, v1, v2, v3), 11);
+}
+
+TEST(MultiVisitTest, DispatchesLargeProductsThroughTable) {
+    Tags16 v1(std::in_place_index<13>);
+    Tags16 v2(std::in_place_index<6>);
+    auto visitor = [](const auto& lhs, const auto& rhs) { return lhs.value * 16 + rhs.value; };
+    EXPECT_EQ(visit(visitor, v1, v2), 13 * 16 + 6);
+    v1.emplace<15>();
+    v2.emplace<15>();
+    EXPECT_EQ(visit(visitor, v1, v2), 255);
+}
+
+TEST(MultiVisitTest, PreservesValueCategory) {
+    Variant<int, std::string> v1(std::in_place_type<std::string>, "abc");
+    Variant<int, std::string> v2(std::in_place_type<std::string>, "def");
+    std::string moved = visit([](auto&& lhs, auto&& rhs) -> std::string {
+        if constexpr (std::is_same_v<std::remove_cvref_t<decltype(lhs)>, std::string>) {
+            std::string result = std::forward<decltype(lhs)>(lhs);
+            static_assert(std::is_rvalue_reference_v<decltype(lhs)>);
+            static_assert(std::is_lvalue_reference_v<decltype(rhs)>);
+            return result;
+        }
+        else {
+            return {};
+        }
+    }, std::move(v1), v2);
+    EXPECT_EQ(moved, "abc");
+    EXPECT_EQ(v2.get<std::string>(), "def");
+}
+
+TEST(MultiVisitTest, ThrowsIf_AnyIsValueless) {
+    static_assert(!Variant<ThrowingType>::never_valueless);
+    Variant<ThrowingType> v1, v2;
+    try { v2.emplace<ThrowingType>(1); }
+    catch (...) {}
+    EXPECT_THROW(visit([](auto&, auto&) {}, v1, v2), std::bad_variant_access);
+}
+
+TEST(MultiVisitTest, IsConstexpr) {
+    constexpr Variant<int, double> v1(2.0);
+    constexpr Variant<int, long> v2(3);
+    static_assert(visit([](auto lhs, auto rhs) { return static_cast<int>(lhs * rhs); }, v1, v2) == 6);
+}